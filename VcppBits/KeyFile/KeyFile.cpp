@@ -31,17 +31,46 @@
 #include <cassert>
 #include <fstream>
 
+#include "VcppBits/StringUtils/Builder.hpp"
+#include "VcppBits/StringUtils/LineReader.hpp"
 #include "VcppBits/StringUtils/StringUtils.hpp"
 
 namespace VcppBits {
 
-KeyFileSettingsIterator::KeyFileSettingsIterator (KeyFileSettings::iterator b,
-                                                  KeyFileSettings::iterator e,
-                                                  KeyFileSettings &settings)
-    : mBegin (b),
-      mEnd (e),
-      mCurrent (b),
-      mSettings (settings),
+void KeyFileSection::insert (const std::string &key, const std::string &value) {
+    const auto res = settings.insert(KeyFileSettings::value_type(key, value));
+    if (res.second) {
+        index(res.first);
+    }
+}
+
+
+void KeyFileSection::assign (const std::string &key, const std::string &value) {
+    const auto res = settings.insert_or_assign(key, value);
+    if (res.second) {
+        index(res.first);
+    }
+}
+
+
+void KeyFileSection::index (KeyFileSettings::iterator it) {
+    // keys differing only in case share a slot; the smallest one wins,
+    // so lookups don't depend on insertion order
+    const auto res = folded.emplace(it->first, it);
+    if (!res.second && it->first < res.first->second->first) {
+        folded.erase(res.first);
+        folded.emplace(it->first, it);
+    }
+}
+
+
+
+
+KeyFileSettingsIterator::KeyFileSettingsIterator (KeyFileSection &section)
+    : mBegin (section.settings.begin()),
+      mEnd (section.settings.end()),
+      mCurrent (mBegin),
+      mSection (section),
       mCurrentIsElement (!(mCurrent == mEnd)) {
 }
 
@@ -92,11 +121,28 @@ std::string KeyFileSettingsIterator::getValue () const {
 
 
 std::string KeyFileSettingsIterator::findSetting (const std::string &name) const {
-    if (!mSettings.count(name)) {
+    const auto it = mSection.settings.find(name);
+    if (it == mSection.settings.end()) {
         throw KeyFileSettingNotFoundException();
     }
 
-    return mSettings[name];
+    return it->second;
+}
+
+
+std::string
+KeyFileSettingsIterator::findSettingIgnoreCase (const std::string &name) const {
+    const auto exact = mSection.settings.find(name);
+    if (exact != mSection.settings.end()) {
+        return exact->second;
+    }
+
+    const auto folded = mSection.folded.find(std::string_view(name));
+    if (folded != mSection.folded.end()) {
+        return folded->second->second;
+    }
+
+    throw KeyFileSettingNotFoundException();
 }
 
 
@@ -144,9 +190,7 @@ KeyFileSettingsIterator KeyFileSectionsIterator::getSettingsIterator () const {
         throw KeyFileOutOfRangeException();
     }
 
-    return KeyFileSettingsIterator(mCurrent->second->begin(),
-                             mCurrent->second->end(),
-                             *mCurrent->second);
+    return KeyFileSettingsIterator(*mCurrent->second);
 }
 
 
@@ -159,38 +203,38 @@ KeyFile::KeyFile (const std::string &filename) {
                              + filename);
     }
 
-    std::string str;
-    std::shared_ptr<KeyFileSettings> current_settings(new KeyFileSettings());
+    std::shared_ptr<KeyFileSection> current_settings(new KeyFileSection());
     std::string current_section_name("");
 
     mSections.insert(
         KeyFileSections::value_type(current_section_name,
                               current_settings));
 
-    while(!StringUtils::safeGetline(file, str).eof() || !file.fail()) {
-        str = StringUtils::trim(str, " \t");
+    StringUtils::LineReader reader(file);
+    std::string_view str;
+    while (reader.getLine(str)) {
+        str = StringUtils::trimView(str, " \t");
 
         if (str.length() > 0 && str.at(0) != '#') {
             if (str.at(0) == '[' && str.at(str.length() - 1) == ']') {
                 current_section_name = str.substr(1, str.length() - 2);
-                current_settings.reset(new KeyFileSettings());
+                current_settings.reset(new KeyFileSection());
 
                 mSections.insert(
                             KeyFileSections::value_type(current_section_name,
                                                   current_settings));
             }
             else {
-                std::string::size_type separator_pos =
+                std::string_view::size_type separator_pos =
                         str.find_first_of(" \n\0", 0);
-                std::string val_name = str.substr(0, separator_pos);
-                std::string val =
-                        (separator_pos + 1 == std::string::npos
-                         || separator_pos == std::string::npos)
-                        ? ""
-                        : str.substr(separator_pos + 1);
-
-                current_settings->insert(
-                            KeyFileSettings::value_type(val_name, val));
+                std::string val_name(str.substr(0, separator_pos));
+                std::string val(
+                        (separator_pos + 1 == std::string_view::npos
+                         || separator_pos == std::string_view::npos)
+                        ? std::string_view()
+                        : str.substr(separator_pos + 1));
+
+                current_settings->insert(val_name, val);
             }
         }
     }
@@ -213,11 +257,9 @@ size_t KeyFile::sectionCount (const std::string &pSectionName) const {
 
 KeyFileSettingsIterator
 KeyFile::getLastSectionSettings (const std::string &pSectionName) const {
-    std::shared_ptr<KeyFileSettings> settings(
+    std::shared_ptr<KeyFileSection> settings(
                 (--mSections.upper_bound(pSectionName))->second);
-    return KeyFileSettingsIterator(settings->begin(),
-                             settings->end(),
-                             *settings);
+    return KeyFileSettingsIterator(*settings);
 }
 
 void KeyFile::appendKey (const std::string &section,
@@ -229,10 +271,10 @@ void KeyFile::appendKey (const std::string &section,
             + section);
     }
 
-    std::shared_ptr<KeyFileSettings> settings;
+    std::shared_ptr<KeyFileSection> settings;
 
     if (mSections.find(section) == mSections.end()) {
-        settings.reset(new KeyFileSettings());
+        settings.reset(new KeyFileSection());
 
         mSections.insert(
             KeyFileSections::value_type(section, settings));
@@ -242,7 +284,7 @@ void KeyFile::appendKey (const std::string &section,
         settings = (*it).second;
     }
 
-    (*settings)[key] = value;
+    settings->assign(key, value);
 }
 
 
@@ -269,22 +311,25 @@ void KeyFile::appendKey (const std::string &key, const std::string &value) {
 
 
 void KeyFile::writeToFile (const std::string &filename) {
-    std::ofstream file(filename.c_str());
+    StringUtils::Builder out(4096);
     KeyFileSectionsIterator sections = getSectionsIterator();
 
     for (;sections.isElement(); sections.peekNext()) {
         if (!sections.getName().empty()) {
-            file << "[" << sections.getName() << "]" << std::endl;
+            out << '[' << sections.getName() << "]\n";
         }
 
         KeyFileSettingsIterator settings = sections.getSettingsIterator();
 
         for (;settings.isElement(); settings.peekNext()) {
-            file << settings.getName() << " "
-                 << settings.getValue()
-                 << std::endl;
+            out << settings.getName() << ' '
+                << settings.getValue()
+                << '\n';
         }
     }
+
+    std::ofstream file(filename.c_str());
+    file.write(out.data(), std::streamsize(out.size()));
 }
 
 } // namespace VcppBits
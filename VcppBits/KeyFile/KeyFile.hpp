@@ -28,21 +28,47 @@
 #include <map>
 #include <stdexcept>
 #include <memory>
+#include <string_view>
+
+#include "VcppBits/StringUtils/AsciiCase.hpp"
 
 namespace VcppBits {
 
 typedef std::map<std::string, std::string> KeyFileSettings;
+
+// settings of one section plus an ASCII case-folded index over their keys;
+// index keys are views of the settings' keys, so a section is not copyable
+class KeyFileSection {
+public:
+    typedef std::map<std::string_view,
+                     KeyFileSettings::iterator,
+                     StringUtils::IgnoreCaseLess> FoldedIndex;
+
+    KeyFileSection () = default;
+    KeyFileSection (const KeyFileSection&) = delete;
+    KeyFileSection& operator= (const KeyFileSection&) = delete;
+
+    // keeps the existing value, like std::map::insert
+    void insert (const std::string &key, const std::string &value);
+    // overwrites the existing value, like std::map::operator[]
+    void assign (const std::string &key, const std::string &value);
+
+    KeyFileSettings settings;
+    FoldedIndex folded;
+
+private:
+    void index (KeyFileSettings::iterator it);
+};
+
 typedef std::multimap<std::string,
-                      std::shared_ptr<KeyFileSettings>> KeyFileSections;
+                      std::shared_ptr<KeyFileSection>> KeyFileSections;
 
 class KeyFileOutOfRangeException {};
 class KeyFileSettingNotFoundException {};
 
 class KeyFileSettingsIterator {
 public:
-    KeyFileSettingsIterator (KeyFileSettings::iterator b,
-                             KeyFileSettings::iterator e,
-                             KeyFileSettings &settings);
+    KeyFileSettingsIterator (KeyFileSection &section);
 
     void peekNext ();
     bool isElement () const;
@@ -52,13 +78,15 @@ public:
     std::string getValue () const;
 
     std::string findSetting (const std::string &name) const;
+    // ASCII-only case folding, exact match is preferred
+    std::string findSettingIgnoreCase (const std::string &name) const;
 
 private:
     const KeyFileSettings::iterator mBegin;
     const KeyFileSettings::iterator mEnd;
     KeyFileSettings::iterator mCurrent;
 
-    KeyFileSettings &mSettings;
+    KeyFileSection &mSection;
 
     bool mCurrentIsElement;
 };
@@ -92,7 +120,7 @@ public:
 
     KeyFile (const std::string &filename);
     KeyFile () {
-        std::shared_ptr<KeyFileSettings> current_settings(new KeyFileSettings());
+        std::shared_ptr<KeyFileSection> current_settings(new KeyFileSection());
         std::string current_section_name("");
 
         mSections.insert(
@@ -0,0 +1,246 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_PARALLEL_HPP_INCLUDED__
+#define VcppBits_PARALLEL_HPP_INCLUDED__
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "VcppBits/Parallel/ThreadPool.hpp"
+
+// Data-parallel loops over contiguous ranges: raw pointer and size, or any
+// container with data() and size(), like SimpleVector or std::vector.
+//
+// Ranges are cut into chunks of pGrain elements, chunk boundaries depend on
+// the grain only, never on the number of threads, so reduce() combines the
+// same partial results in the same order on every machine.
+
+namespace VcppBits {
+namespace Parallel {
+
+constexpr size_t DEFAULT_GRAIN = 4096;
+
+// pFunc(begin, end) for consecutive chunks covering [0, pCount)
+template <typename FuncT>
+void forChunks (const size_t pCount,
+                FuncT &&pFunc,
+                const size_t pGrain = DEFAULT_GRAIN,
+                ThreadPool &pPool = ThreadPool::global()) {
+    const size_t grain = std::max<size_t>(pGrain, 1);
+    const size_t chunks = (pCount + grain - 1) / grain;
+    pPool.run(chunks, [&] (const size_t pChunk) {
+        const size_t begin = pChunk * grain;
+        pFunc(begin, std::min(begin + grain, pCount));
+    });
+}
+
+// pFunc(i) for every i in [0, pCount)
+template <typename FuncT>
+void parallelFor (const size_t pCount,
+                  FuncT &&pFunc,
+                  const size_t pGrain = DEFAULT_GRAIN,
+                  ThreadPool &pPool = ThreadPool::global()) {
+    forChunks(pCount,
+              [&pFunc] (const size_t pBegin, const size_t pEnd) {
+                  for (size_t i = pBegin; i < pEnd; ++i) {
+                      pFunc(i);
+                  }
+              },
+              pGrain,
+              pPool);
+}
+
+// pFunc(element) for every element
+template <typename T, typename FuncT>
+void forEach (T *pData,
+              const size_t pSize,
+              FuncT &&pFunc,
+              const size_t pGrain = DEFAULT_GRAIN,
+              ThreadPool &pPool = ThreadPool::global()) {
+    forChunks(pSize,
+              [pData, &pFunc] (const size_t pBegin, const size_t pEnd) {
+                  for (size_t i = pBegin; i < pEnd; ++i) {
+                      pFunc(pData[i]);
+                  }
+              },
+              pGrain,
+              pPool);
+}
+
+template <typename ContainerT, typename FuncT>
+void forEach (ContainerT &pContainer,
+              FuncT &&pFunc,
+              const size_t pGrain = DEFAULT_GRAIN,
+              ThreadPool &pPool = ThreadPool::global()) {
+    forEach(pContainer.data(),
+            pContainer.size(),
+            std::forward<FuncT>(pFunc),
+            pGrain,
+            pPool);
+}
+
+// pOut[i] = pFunc(pIn[i]), pOut must have room for pSize elements
+template <typename InT, typename OutT, typename FuncT>
+void transform (const InT *pIn,
+                const size_t pSize,
+                OutT *pOut,
+                FuncT &&pFunc,
+                const size_t pGrain = DEFAULT_GRAIN,
+                ThreadPool &pPool = ThreadPool::global()) {
+    forChunks(pSize,
+              [pIn, pOut, &pFunc] (const size_t pBegin, const size_t pEnd) {
+                  for (size_t i = pBegin; i < pEnd; ++i) {
+                      pOut[i] = pFunc(pIn[i]);
+                  }
+              },
+              pGrain,
+              pPool);
+}
+
+// pOut is resized to pIn.size()
+template <typename InContainerT, typename OutContainerT, typename FuncT>
+void transform (const InContainerT &pIn,
+                OutContainerT &pOut,
+                FuncT &&pFunc,
+                const size_t pGrain = DEFAULT_GRAIN,
+                ThreadPool &pPool = ThreadPool::global()) {
+    pOut.resize(pIn.size());
+    transform(pIn.data(),
+              pIn.size(),
+              pOut.data(),
+              std::forward<FuncT>(pFunc),
+              pGrain,
+              pPool);
+}
+
+// pInit combined with all elements by pOp, which must be associative. Each
+// chunk is folded left to right, then chunk results are folded in chunk
+// order, so results are reproducible for a given grain, floats included.
+// Chunks start from their first element and partials are combined with pOp
+// too, so pOp(ResultT, T) and pOp(ResultT, ResultT) must be the same
+// operation. For anything else, e.g. counting, use fold()
+template <typename T, typename ResultT, typename OpT>
+ResultT reduce (const T *pData,
+                const size_t pSize,
+                ResultT pInit,
+                OpT &&pOp,
+                const size_t pGrain = DEFAULT_GRAIN,
+                ThreadPool &pPool = ThreadPool::global()) {
+    if (pSize == 0) {
+        return pInit;
+    }
+    const size_t grain = std::max<size_t>(pGrain, 1);
+    std::vector<ResultT> partials((pSize + grain - 1) / grain);
+    forChunks(pSize,
+              [pData, grain, &partials, &pOp] (const size_t pBegin,
+                                                const size_t pEnd) {
+                  ResultT acc = pData[pBegin];
+                  for (size_t i = pBegin + 1; i < pEnd; ++i) {
+                      acc = pOp(acc, pData[i]);
+                  }
+                  partials[pBegin / grain] = std::move(acc);
+              },
+              grain,
+              pPool);
+
+    for (auto &partial : partials) {
+        pInit = pOp(pInit, std::move(partial));
+    }
+    return pInit;
+}
+
+template <typename ContainerT, typename ResultT, typename OpT>
+ResultT reduce (const ContainerT &pContainer,
+                ResultT pInit,
+                OpT &&pOp,
+                const size_t pGrain = DEFAULT_GRAIN,
+                ThreadPool &pPool = ThreadPool::global()) {
+    return reduce(pContainer.data(),
+                  pContainer.size(),
+                  std::move(pInit),
+                  std::forward<OpT>(pOp),
+                  pGrain,
+                  pPool);
+}
+
+// Like reduce(), but every chunk starts from pIdentity and folds its
+// elements with pOp(acc, element), so elements may be of another type than
+// the result. Chunk results are combined in chunk order with
+// pCombine(acc, partial)
+template <typename T, typename ResultT, typename OpT, typename CombineT>
+ResultT fold (const T *pData,
+              const size_t pSize,
+              const ResultT &pIdentity,
+              OpT &&pOp,
+              CombineT &&pCombine,
+              const size_t pGrain = DEFAULT_GRAIN,
+              ThreadPool &pPool = ThreadPool::global()) {
+    if (pSize == 0) {
+        return pIdentity;
+    }
+    const size_t grain = std::max<size_t>(pGrain, 1);
+    std::vector<ResultT> partials((pSize + grain - 1) / grain, pIdentity);
+    forChunks(pSize,
+              [pData, grain, &pIdentity, &partials, &pOp]
+              (const size_t pBegin, const size_t pEnd) {
+                  ResultT acc = pIdentity;
+                  for (size_t i = pBegin; i < pEnd; ++i) {
+                      acc = pOp(std::move(acc), pData[i]);
+                  }
+                  partials[pBegin / grain] = std::move(acc);
+              },
+              grain,
+              pPool);
+
+    ResultT res = std::move(partials[0]);
+    for (size_t i = 1; i < partials.size(); ++i) {
+        res = pCombine(std::move(res), std::move(partials[i]));
+    }
+    return res;
+}
+
+template <typename ContainerT, typename ResultT, typename OpT, typename CombineT>
+ResultT fold (const ContainerT &pContainer,
+              const ResultT &pIdentity,
+              OpT &&pOp,
+              CombineT &&pCombine,
+              const size_t pGrain = DEFAULT_GRAIN,
+              ThreadPool &pPool = ThreadPool::global()) {
+    return fold(pContainer.data(),
+                pContainer.size(),
+                pIdentity,
+                std::forward<OpT>(pOp),
+                std::forward<CombineT>(pCombine),
+                pGrain,
+                pPool);
+}
+
+} // namespace Parallel
+} // namespace VcppBits
+
+#endif // VcppBits_PARALLEL_HPP_INCLUDED__
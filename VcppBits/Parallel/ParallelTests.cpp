@@ -0,0 +1,128 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <VcppBits/contrib/catch2/catch.hpp>
+
+#include "VcppBits/SimpleVector/SimpleVector.hpp"
+
+#include "Parallel.hpp"
+
+using namespace VcppBits;
+
+TEST_CASE("parallelFor visits every index once", "[Parallel]") {
+    Parallel::ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(10000);
+    Parallel::parallelFor(visits.size(),
+                          [&visits] (const size_t pI) { ++visits[pI]; },
+                          64,
+                          pool);
+    bool once = true;
+    for (const auto &count : visits) {
+        once = once && count == 1;
+    }
+    CHECK(once);
+
+    // nested loops run on the same pool
+    std::atomic<int> inner { 0 };
+    Parallel::parallelFor(8,
+                          [&] (size_t) {
+                              Parallel::parallelFor(100,
+                                                    [&] (size_t) { ++inner; },
+                                                    10,
+                                                    pool);
+                          },
+                          1,
+                          pool);
+    CHECK(inner == 800);
+}
+
+TEST_CASE("Parallel transform and reduce over SimpleVector", "[Parallel]") {
+    Parallel::ThreadPool pool(3);
+    SimpleVector<float> in;
+    for (int i = 0; i < 100000; ++i) {
+        in.push_back(float(i % 100) * 0.01f);
+    }
+    SimpleVector<double> out;
+    Parallel::transform(in,
+                        out,
+                        [] (const float pX) { return double(pX) * 2; },
+                        1000,
+                        pool);
+    REQUIRE(out.size() == in.size());
+    CHECK(out[150] == Approx(1.0));
+
+    const auto plus = [] (const float pA, const float pB) { return pA + pB; };
+    const float sum = Parallel::reduce(in, 0.f, plus, 1000, pool);
+    // same chunks, same order, whatever the number of threads
+    Parallel::ThreadPool single(1);
+    CHECK(sum == Parallel::reduce(in, 0.f, plus, 1000, single));
+    CHECK(sum == Approx(49500.f));
+}
+
+TEST_CASE("Parallel fold counts with a heterogeneous op", "[Parallel]") {
+    struct Sample {
+        int value;
+        bool valid;
+    };
+    SimpleVector<Sample> samples;
+    for (int i = 0; i < 10000; ++i) {
+        samples.push_back({ i, i % 3 == 0 });
+    }
+    const auto count_valid = [] (const size_t pCount, const Sample &pSample) {
+        return pCount + (pSample.valid ? 1 : 0);
+    };
+    const auto add = [] (const size_t pA, const size_t pB) {
+        return pA + pB;
+    };
+
+    Parallel::ThreadPool pool(3);
+    const size_t valid =
+        Parallel::fold(samples, size_t(0), count_valid, add, 100, pool);
+    CHECK(valid == 3334);
+    CHECK(Parallel::fold(samples.data(), 0, size_t(7), count_valid, add)
+          == 7);
+}
+
+TEST_CASE("ThreadPool passes exceptions to the caller", "[Parallel]") {
+    Parallel::ThreadPool pool(4);
+    CHECK_THROWS_AS(pool.run(100,
+                             [] (const size_t pI) {
+                                 if (pI == 42) {
+                                     throw std::runtime_error("42");
+                                 }
+                             }),
+                    std::runtime_error);
+    std::atomic<size_t> count { 0 };
+    pool.run(100, [&count] (size_t) { ++count; });
+    CHECK(count == 100);
+}
@@ -0,0 +1,216 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "VcppBits/Parallel/ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace VcppBits {
+namespace Parallel {
+
+struct ThreadPool::Job {
+    Job (const size_t pCount, const TaskFunc pFunc, void *pContext)
+        : count (pCount),
+          func (pFunc),
+          context (pContext) {
+    }
+
+    const size_t count;
+    const TaskFunc func;
+    void *const context;
+    std::atomic<size_t> next { 0 };
+    std::atomic<bool> failed { false };
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    size_t done = 0;
+    // workers that picked the job up and may still touch it
+    size_t workers = 0;
+    std::exception_ptr error;
+
+    // guarded by ThreadPool::_mutex
+    Job *nextJob = nullptr;
+    bool queued = false;
+};
+
+ThreadPool::ThreadPool (const size_t pThreads) {
+    const size_t workers = std::max<size_t>(pThreads, 1) - 1;
+    _workers.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        _workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool () {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wakeUp.notify_all();
+    for (auto &worker : _workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::defaultThreadCount () {
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+ThreadPool& ThreadPool::global () {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::runTasks (const size_t pCount,
+                           const TaskFunc pFunc,
+                           void *pContext) {
+    if (pCount == 0) {
+        return;
+    }
+    if (pCount == 1 || _workers.empty()) {
+        for (size_t i = 0; i < pCount; ++i) {
+            pFunc(pContext, i);
+        }
+        return;
+    }
+
+    Job job(pCount, pFunc, pContext);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        pushJob(job);
+    }
+    _wakeUp.notify_all();
+
+    work(job);
+
+    {
+        // no worker can pick the job up after this
+        std::lock_guard<std::mutex> lock(_mutex);
+        unlinkJob(job);
+    }
+    std::unique_lock<std::mutex> lock(job.mutex);
+    job.finished.wait(lock, [&job] {
+        return job.done == job.count && job.workers == 0;
+    });
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+void ThreadPool::pushJob (Job &pJob) {
+    if (_lastJob) {
+        _lastJob->nextJob = &pJob;
+    }
+    else {
+        _firstJob = &pJob;
+    }
+    _lastJob = &pJob;
+    pJob.queued = true;
+}
+
+void ThreadPool::unlinkJob (Job &pJob) {
+    if (!pJob.queued) {
+        return;
+    }
+    Job *prev = nullptr;
+    Job *current = _firstJob;
+    while (current != &pJob) {
+        prev = current;
+        current = current->nextJob;
+    }
+    (prev ? prev->nextJob : _firstJob) = pJob.nextJob;
+    if (_lastJob == &pJob) {
+        _lastJob = prev;
+    }
+    pJob.nextJob = nullptr;
+    pJob.queued = false;
+}
+
+void ThreadPool::workerLoop () {
+    for (;;) {
+        Job *job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wakeUp.wait(lock, [this] { return _stopping || _firstJob; });
+            if (_stopping) {
+                return;
+            }
+            job = _firstJob;
+            // all indices handed out, nothing left for others to pick up
+            if (job->next.load(std::memory_order_relaxed) >= job->count) {
+                unlinkJob(*job);
+                continue;
+            }
+            std::lock_guard<std::mutex> job_lock(job->mutex);
+            ++job->workers;
+        }
+        work(*job);
+
+        std::lock_guard<std::mutex> job_lock(job->mutex);
+        if (--job->workers == 0 && job->done == job->count) {
+            job->finished.notify_all();
+        }
+    }
+}
+
+void ThreadPool::work (Job &pJob) {
+    size_t completed = 0;
+    for (;;) {
+        const size_t i = pJob.next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= pJob.count) {
+            break;
+        }
+        if (!pJob.failed.load(std::memory_order_relaxed)) {
+            try {
+                pJob.func(pJob.context, i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(pJob.mutex);
+                if (!pJob.error) {
+                    pJob.error = std::current_exception();
+                }
+                pJob.failed = true;
+            }
+        }
+        ++completed;
+    }
+
+    if (completed) {
+        std::lock_guard<std::mutex> lock(pJob.mutex);
+        pJob.done += completed;
+        if (pJob.done == pJob.count) {
+            pJob.finished.notify_all();
+        }
+    }
+}
+
+} // namespace Parallel
+} // namespace VcppBits
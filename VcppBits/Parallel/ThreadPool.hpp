@@ -0,0 +1,101 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_THREAD_POOL_HPP_INCLUDED__
+#define VcppBits_THREAD_POOL_HPP_INCLUDED__
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace VcppBits {
+namespace Parallel {
+
+// Fixed set of worker threads for data-parallel loops. run() hands out task
+// indices to the workers and to the calling thread, which works too, so
+// nested run() calls from inside tasks don't deadlock.
+//
+// run() doesn't allocate: the job lives on the caller's stack and is queued
+// through an intrusive list, the caller waits until the last worker lets go
+// of it.
+class ThreadPool {
+public:
+    // pThreads includes the calling thread, so 1 means no workers at all
+    explicit ThreadPool (const size_t pThreads = defaultThreadCount());
+    ~ThreadPool ();
+
+    ThreadPool (const ThreadPool&) = delete;
+    ThreadPool& operator= (const ThreadPool&) = delete;
+
+    // pTask(i) for every i in [0, pCount), returns when all are done. First
+    // exception thrown by a task is rethrown here, remaining tasks are
+    // skipped
+    template <typename TaskT>
+    void run (const size_t pCount, TaskT &&pTask) {
+        using Task = std::remove_reference_t<TaskT>;
+        runTasks(pCount,
+                 [] (void *pContext, const size_t pIndex) {
+                     (*static_cast<Task*>(pContext))(pIndex);
+                 },
+                 const_cast<void*>(static_cast<const void*>(&pTask)));
+    }
+
+    size_t getThreadCount () const {
+        return _workers.size() + 1;
+    }
+
+    static size_t defaultThreadCount ();
+
+    // created on first use with defaultThreadCount() threads
+    static ThreadPool& global ();
+
+private:
+    struct Job;
+    using TaskFunc = void (*) (void *pContext, size_t pIndex);
+
+    void runTasks (const size_t pCount, TaskFunc pFunc, void *pContext);
+    void workerLoop ();
+    static void work (Job &pJob);
+
+    // both are called with _mutex locked
+    void pushJob (Job &pJob);
+    void unlinkJob (Job &pJob);
+
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _wakeUp;
+    // FIFO of jobs with indices left, linked through Job::nextJob
+    Job *_firstJob = nullptr;
+    Job *_lastJob = nullptr;
+    bool _stopping = false;
+};
+
+} // namespace Parallel
+} // namespace VcppBits
+
+#endif // VcppBits_THREAD_POOL_HPP_INCLUDED__
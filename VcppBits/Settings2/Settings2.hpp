@@ -28,15 +28,18 @@
 #include <iostream>
 #include <variant>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <functional>
 
 #include "VcppBits/StringUtils/StringUtils.hpp"
+#include "VcppBits/StringUtils/Symbol.hpp"
 #include "VcppBits/KeyFile/KeyFile.hpp"
 
 namespace V2 {
 
 using VcppBits::KeyFile;
+using VcppBits::StringUtils::Symbol;
 
 template<typename T>
 struct NoneConstraint {
@@ -486,6 +489,13 @@ public:
     using SettingsMap = std::map<std::string, SettingT>;
     using SettingsPtrsMap = std::map<std::string, SettingT*>;
     using SettingsCategories = std::map<std::string, SettingsPtrsMap>;
+    // keys are views of _values' keys
+    using SettingsIndex = std::unordered_map<Symbol, SettingT*>;
+    using SettingsFoldedIndex =
+        std::unordered_map<std::string_view,
+                           SettingT*,
+                           VcppBits::StringUtils::IgnoreCaseHash,
+                           VcppBits::StringUtils::IgnoreCaseEqual>;
 
     class SettingsSectionView {
     public:
@@ -574,10 +584,13 @@ public:
                 const std::string prefix =
                     sec_name.empty() ? "" : sec_name + ".";
                 while (set_iter.isElement()) {
-                    if (_values.count(prefix + set_iter.getName())) {
+                    // config files are operator-edited, so names match
+                    // ignoring ASCII case; exact match is preferred
+                    SettingT *found = findSettingIgnoreCase(
+                        prefix + set_iter.getName());
+                    if (found) {
                         try {
-                            _values.at(prefix + set_iter.getName())
-                                .setByString(set_iter.getValue());
+                            found->setByString(set_iter.getValue());
                         }
                         catch (const SettingsException& oor) {
                             (void) oor;
@@ -629,28 +642,49 @@ public:
     }
 
 
-    const SettingT& getSetting (const std::string& pName) const {
-        if (_valuesMap.count(pName) < 1) {
-            throw SettingsException("Setting " + pName + " not found",
-                                    SettingsException::Type::NOT_FOUND);
+    // pass names as Symbols (e.g. "foo.bar"_sym) to hash them only once
+    const SettingT& getSetting (const Symbol& pName) const {
+        const auto it = _valuesMap.find(pName);
+        if (it == _valuesMap.end()) {
+            throw SettingsException(
+                "Setting " + pName.toString() + " not found",
+                SettingsException::Type::NOT_FOUND);
         }
 
-        return *_valuesMap.at(pName);
+        return *it->second;
     }
 
-    SettingT& getSetting (const std::string& pName) {
-        if (_valuesMap.count(pName) < 1) {
-            throw SettingsException("Setting " + pName + " not found",
-                                    SettingsException::Type::NOT_FOUND);
+    SettingT& getSetting (const Symbol& pName) {
+        const auto it = _valuesMap.find(pName);
+        if (it == _valuesMap.end()) {
+            throw SettingsException(
+                "Setting " + pName.toString() + " not found",
+                SettingsException::Type::NOT_FOUND);
         }
 
-        return *_valuesMap.at(pName);
+        return *it->second;
     }
 
-    bool hasSetting (const std::string& pName) const {
+    bool hasSetting (const Symbol& pName) const {
         return _valuesMap.count(pName);
     }
 
+    // ASCII-only case folding, exact match is preferred
+    SettingT& getSettingIgnoreCase (const std::string_view pName) {
+        SettingT *found = findSettingIgnoreCase(pName);
+        if (!found) {
+            throw SettingsException(
+                "Setting " + std::string(pName) + " not found",
+                SettingsException::Type::NOT_FOUND);
+        }
+
+        return *found;
+    }
+
+    bool hasSettingIgnoreCase (const std::string_view pName) const {
+        return _valuesFolded.count(pName);
+    }
+
     template <typename... Args>
     SettingT& appendSetting (const std::string &pName,
                              Args... pArgs) {
@@ -661,12 +695,10 @@ public:
         }
 
         auto res = _values.emplace(pName, pArgs...);
-        // TODO use it?
-        (void) res;
 
-        SettingT& inserted_set = _values.at(pName);
-        _valuesMap.insert(typename SettingsPtrsMap::value_type(pName,
-                                                               &inserted_set));
+        SettingT& inserted_set = res.first->second;
+        _valuesMap.emplace(Symbol(res.first->first), &inserted_set);
+        indexFolded(res.first->first, &inserted_set);
 
         size_t n = pName.find('.', 0);
         std::string categ_name =
@@ -683,25 +715,44 @@ public:
     }
 
     template<typename T>
-    const typename T::value_type& get (const std::string& pName) const {
+    const typename T::value_type& get (const Symbol& pName) const {
         return getSetting(pName).template get<T>();
     }
 
     template<typename T>
-    void set (const std::string& pName,
+    void set (const Symbol& pName,
               const typename T::value_type &pNewVal) {
         return getSetting(pName).template set<T>(pNewVal);
     }
 
     template<typename T>
-    void triggerListeners (const std::string& pName) {
+    void triggerListeners (const Symbol& pName) {
         return getSetting(pName).template triggerListeners<T>();
     }
 
 private:
+    SettingT* findSettingIgnoreCase (const std::string_view pName) {
+        const auto exact = _valuesMap.find(Symbol(pName));
+        if (exact != _valuesMap.end()) {
+            return exact->second;
+        }
+        const auto folded = _valuesFolded.find(pName);
+        return folded == _valuesFolded.end() ? nullptr : folded->second;
+    }
+
+    // names differing only in case share a slot; the smallest one wins,
+    // so lookups don't depend on registration order
+    void indexFolded (const std::string& pName, SettingT *pSetting) {
+        const auto res = _valuesFolded.emplace(pName, pSetting);
+        if (!res.second && pName < res.first->first) {
+            _valuesFolded.erase(res.first);
+            _valuesFolded.emplace(pName, pSetting);
+        }
+    }
 
     SettingsMap _values;
-    SettingsPtrsMap _valuesMap;
+    SettingsIndex _valuesMap;
+    SettingsFoldedIndex _valuesFolded;
     SettingsCategories _categories;
     std::string _filename;
 };
@@ -31,6 +31,8 @@
 
 #include "VcppBits/contrib/catch2/catch.hpp"
 #include "Settings2.hpp"
+#include "VcppBits/StringUtils/Builder.hpp"
+#include "VcppBits/StringUtils/ParseNumbers.hpp"
 
 using namespace V2;
 
@@ -59,23 +61,23 @@ struct Vector3 {
 // specializing SettingValue
 
 inline std::string vector3_to_string (const Vector3& pVector3) {
-    std::stringstream ss;
-    ss << std::fixed;
-    ss << "Vector3(" << pVector3.x << " "
-        << pVector3.y << " "
-        << pVector3.z << ")";
-    return ss.str();
+    VcppBits::StringUtils::Builder b(64);
+    b << "Vector3(";
+    b.appendFixed(pVector3.x) << ' ';
+    b.appendFixed(pVector3.y) << ' ';
+    b.appendFixed(pVector3.z) << ')';
+    return b.str();
 }
 
 inline Vector3 vector3_from_string (const std::string &pStr) {
-    using VcppBits::StringUtils::fromString;
+    using VcppBits::StringUtils::parseNumbers;
     if (pStr.find("Vector3(") == 0
         && pStr[pStr.size() - 1] == ')') {
-        Vector3 ret;
-        std::stringstream ss(pStr.substr(8, pStr.size() - 1));
-        ss >> ret.x >> ret.y >> ret.z;
-
-        return ret;
+        float xyz[3];
+        const auto str = std::string_view(pStr).substr(8, pStr.size() - 9);
+        if (parseNumbers(str, xyz) == 3) {
+            return Vector3{ xyz[0], xyz[1], xyz[2] };
+        }
     }
 
     throw std::runtime_error("couldn't parse Vector3 from: " + pStr);
@@ -137,6 +139,10 @@ TEST_CASE("Test our custom Vector3 utilities", "[Vector3]") {
 
     REQUIRE(vector3_from_string(vector3_to_string(a_vec)) == ApproxV3(a_vec));
     REQUIRE(vector3_to_string(vector3_from_string(a_str)) == a_str);
+
+    REQUIRE_THROWS_AS(vector3_from_string("Vector3(1 2)"), std::runtime_error);
+    REQUIRE_THROWS_AS(vector3_from_string("Vector3(1 2 z)"),
+                      std::runtime_error);
 }
 
 TEST_CASE("Custom Setting initialized", "[Vector3Value]") {
@@ -168,6 +168,52 @@ TEST_CASE("Read some settings", "[Settings2]") {
     REQUIRE(settings.get<FloatValue>("toplevel_float") == Approx(3.1415926f));
     REQUIRE(settings.get<StringValue>("section1.foo") == "a bit longer string");
     REQUIRE(settings.get<EnumIntValue>("section1.bar_int") == 12312);
+
+    using namespace VcppBits::StringUtils::SymbolLiterals;
+    REQUIRE(settings.get<IntValue>("toplevel_int"_sym) == 1241);
+    REQUIRE(settings.hasSetting(std::string("section1.foo")));
+    REQUIRE_FALSE(settings.hasSetting("section1.nope"_sym));
+    REQUIRE_THROWS_AS(settings.getSetting("nope"), SettingsException);
+}
+
+TEST_CASE("Settings are found ignoring case", "[Settings2]") {
+    const auto filename = "test_Settings_1.txt";
+    {
+        std::ofstream myfile(filename);
+        myfile << "TopLevel_Int 7\n"
+               << "[Section1]\n"
+               << "FOO edited by hand\n";
+    }
+
+    {
+        VcppBits::KeyFile file(filename);
+        auto section = file.getLastSectionSettings("Section1");
+        REQUIRE(section.findSettingIgnoreCase("foo") == "edited by hand");
+        REQUIRE_THROWS_AS(section.findSetting("foo"),
+                          VcppBits::KeyFileSettingNotFoundException);
+    }
+
+    {
+        Settings settings(filename);
+        settings.appendSetting("toplevel_int", IntValue(int(0)));
+        settings.appendSetting("section1.foo", StringValue("default_str"));
+        settings.appendSetting("section1.Foo", StringValue("other_str"));
+        settings.load();
+
+        // the exact name wins over a case-folded one
+        REQUIRE(settings.get<IntValue>("toplevel_int") == 7);
+        REQUIRE(settings.get<StringValue>("section1.Foo") == "edited by hand");
+        REQUIRE(settings.get<StringValue>("section1.foo") == "default_str");
+
+        REQUIRE(settings.hasSettingIgnoreCase("TOPLEVEL_INT"));
+        REQUIRE_FALSE(settings.hasSetting("TOPLEVEL_INT"));
+        REQUIRE(&settings.getSettingIgnoreCase("SECTION1.foo")
+                == &settings.getSetting("section1.Foo"));
+        REQUIRE(&settings.getSettingIgnoreCase("section1.foo")
+                == &settings.getSetting("section1.foo"));
+        REQUIRE_THROWS_AS(settings.getSettingIgnoreCase("nope"),
+                          SettingsException);
+    }
 }
 
 TEST_CASE("Setting2 ptr update mechanism", "[Setting2]" ) {
@@ -0,0 +1,458 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_SIMPLE_VECTOR_ALLOCATORS_HPP_INCLUDED__
+#define VcppBits_SIMPLE_VECTOR_ALLOCATORS_HPP_INCLUDED__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Allocators for SimpleVector. Anything with these methods will do:
+//
+//   void* allocate (size_t pBytes, size_t pAlignment); // throws on failure
+//   void deallocate (void *pPtr, size_t pBytes, size_t pAlignment);
+//
+// and optionally, to let trivially copyable elements grow in place:
+//
+//   // returns nullptr if the block can't be resized, pPtr stays valid then
+//   void* reallocate (void *pPtr,
+//                     size_t pOldBytes,
+//                     size_t pNewBytes,
+//                     size_t pAlignment);
+//
+// pBytes passed to deallocate() are always the same as were allocated.
+
+namespace VcppBits {
+
+namespace detail {
+
+template <typename AllocatorT, typename = void>
+struct HasReallocate : std::false_type {};
+
+template <typename AllocatorT>
+struct HasReallocate<AllocatorT,
+                     decltype((void) std::declval<AllocatorT&>().reallocate(
+                                  std::declval<void*>(),
+                                  size_t(),
+                                  size_t(),
+                                  size_t()))>
+    : std::true_type {};
+
+inline size_t alignUp (const size_t pValue, const size_t pAlignment) {
+    return (pValue + pAlignment - 1) & ~(pAlignment - 1);
+}
+
+} // namespace detail
+
+
+// malloc/realloc/free, or aligned operator new for over-aligned requests
+class HeapAllocator {
+public:
+    void* allocate (const size_t pBytes, const size_t pAlignment) {
+        if (isOverAligned(pAlignment)) {
+            return ::operator new(pBytes, std::align_val_t(pAlignment));
+        }
+        void *ptr = std::malloc(pBytes);
+        if (!ptr && pBytes) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void* reallocate (void *pPtr,
+                      const size_t pOldBytes,
+                      const size_t pNewBytes,
+                      const size_t pAlignment) {
+        (void) pOldBytes;
+        if (isOverAligned(pAlignment)) {
+            return nullptr;
+        }
+        void *ptr = std::realloc(pPtr, pNewBytes);
+        if (!ptr && pNewBytes) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void deallocate (void *pPtr, const size_t pBytes, const size_t pAlignment) {
+        (void) pBytes;
+        if (isOverAligned(pAlignment)) {
+            ::operator delete(pPtr, std::align_val_t(pAlignment));
+        }
+        else {
+            std::free(pPtr);
+        }
+    }
+
+private:
+    static bool isOverAligned (const size_t pAlignment) {
+        return pAlignment > alignof(std::max_align_t);
+    }
+};
+
+
+// Hands out memory by bumping a pointer through big chunks. Nothing is freed
+// individually; reset() makes all the memory reusable in O(1), e.g. once per
+// frame. Chunks are kept until the arena is destroyed.
+class BumpArena {
+public:
+    explicit BumpArena (const size_t pChunkSize = 64 * 1024)
+        : _chunkSize (pChunkSize) {
+    }
+
+    BumpArena (const BumpArena&) = delete;
+    BumpArena& operator= (const BumpArena&) = delete;
+
+    ~BumpArena () {
+        for (auto &chunk : _chunks) {
+            std::free(chunk.memory);
+        }
+    }
+
+    void* allocate (const size_t pBytes, const size_t pAlignment) {
+        for (;;) {
+            if (_current < _chunks.size()) {
+                Chunk &chunk = _chunks[_current];
+                const size_t start = alignedOffset(chunk, pAlignment);
+                if (start <= chunk.size && chunk.size - start >= pBytes) {
+                    _last = chunk.memory + start;
+                    _position = start + pBytes;
+                    return _last;
+                }
+                if (_current + 1 < _chunks.size()) {
+                    ++_current;
+                    _position = 0;
+                    continue;
+                }
+            }
+            addChunk(pBytes + pAlignment);
+        }
+    }
+
+    // can only extend the most recent allocation, and only if there is room
+    // left in its chunk
+    bool tryExtend (void *pPtr, const size_t pOldBytes, const size_t pNewBytes) {
+        if (pPtr == nullptr || pPtr != _last) {
+            return false;
+        }
+        const Chunk &chunk = _chunks[_current];
+        const size_t start = size_t(_last - chunk.memory);
+        if (start + pNewBytes > chunk.size) {
+            return false;
+        }
+        (void) pOldBytes;
+        _position = start + pNewBytes;
+        return true;
+    }
+
+    void reset () {
+        _current = 0;
+        _position = 0;
+        _last = nullptr;
+    }
+
+    size_t chunkCount () const {
+        return _chunks.size();
+    }
+
+private:
+    struct Chunk {
+        char *memory;
+        size_t size;
+    };
+
+    size_t alignedOffset (const Chunk &pChunk, const size_t pAlignment) const {
+        const auto base = reinterpret_cast<std::uintptr_t>(pChunk.memory);
+        return size_t(detail::alignUp(base + _position, pAlignment) - base);
+    }
+
+    void addChunk (const size_t pMinSize) {
+        const size_t size = std::max(_chunkSize, pMinSize);
+        char *memory = static_cast<char*>(std::malloc(size));
+        if (!memory) {
+            throw std::bad_alloc();
+        }
+        // keep chunks after the current one for reuse after reset()
+        const size_t pos = _chunks.empty() ? 0 : _current + 1;
+        _chunks.insert(_chunks.begin() + std::ptrdiff_t(pos),
+                       Chunk{ memory, size });
+        _current = pos;
+        _position = 0;
+    }
+
+    const size_t _chunkSize;
+    std::vector<Chunk> _chunks;
+    size_t _current = 0;
+    size_t _position = 0;
+    char *_last = nullptr;
+};
+
+
+class ArenaAllocator {
+public:
+    explicit ArenaAllocator (BumpArena &pArena)
+        : _arena (&pArena) {
+    }
+
+    void* allocate (const size_t pBytes, const size_t pAlignment) {
+        return _arena->allocate(pBytes, pAlignment);
+    }
+
+    void* reallocate (void *pPtr,
+                      const size_t pOldBytes,
+                      const size_t pNewBytes,
+                      const size_t pAlignment) {
+        (void) pAlignment;
+        return _arena->tryExtend(pPtr, pOldBytes, pNewBytes) ? pPtr : nullptr;
+    }
+
+    void deallocate (void*, size_t, size_t) {
+    }
+
+private:
+    BumpArena *_arena;
+};
+
+
+struct SizeClassPoolStats {
+    size_t hits = 0;          // allocations served from the cache
+    size_t misses = 0;        // pooled sizes that went to malloc
+    size_t passedThrough = 0; // too big or over-aligned, not pooled
+    size_t recycled = 0;      // freed blocks kept for reuse
+    size_t released = 0;      // freed blocks given back, the cache was full
+    size_t cachedBlocks = 0;
+    size_t cachedBytes = 0;
+
+    double hitRate () const {
+        const size_t total = hits + misses;
+        return total ? double(hits) / double(total) : 0.;
+    }
+};
+
+
+// Caches freed blocks in power-of-two size classes (16 bytes to 1 MiB), so
+// that short-lived vectors don't go to malloc every time. Bigger or
+// over-aligned blocks are passed through to HeapAllocator.
+//
+// The cache is capped, per class and in total, so that one burst of big
+// vectors doesn't pin memory forever; blocks over the caps go back to free().
+class SizeClassPool {
+public:
+    static constexpr size_t MIN_CLASS_BITS = 4;
+    static constexpr size_t MAX_CLASS_BITS = 20;
+    static constexpr size_t CLASS_COUNT = MAX_CLASS_BITS - MIN_CLASS_BITS + 1;
+
+    struct Limits {
+        size_t maxBlocksPerClass = 64;
+        size_t maxCachedBytes = size_t(16) * 1024 * 1024;
+    };
+
+    SizeClassPool () = default;
+    explicit SizeClassPool (const Limits &pLimits)
+        : _limits (pLimits) {
+    }
+    SizeClassPool (const SizeClassPool&) = delete;
+    SizeClassPool& operator= (const SizeClassPool&) = delete;
+
+    ~SizeClassPool () {
+        trim();
+    }
+
+    // frees all cached blocks
+    void trim () {
+        for (size_t cls = 0; cls < CLASS_COUNT; ++cls) {
+            FreeBlock *block = _freeLists[cls];
+            while (block) {
+                FreeBlock *next = block->next;
+                std::free(block);
+                block = next;
+            }
+            _freeLists[cls] = nullptr;
+            _classCounts[cls] = 0;
+        }
+        _stats.cachedBlocks = 0;
+        _stats.cachedBytes = 0;
+    }
+
+    // lower limits take effect as blocks are freed, or call trim()
+    void setLimits (const Limits &pLimits) {
+        _limits = pLimits;
+    }
+
+    const Limits& getLimits () const {
+        return _limits;
+    }
+
+    const SizeClassPoolStats& getStats () const {
+        return _stats;
+    }
+
+    static SizeClassPool& threadLocal ();
+
+    // true once the calling thread's pool is gone at thread exit. Objects
+    // destroyed after it, like statics on the main thread, must not use it
+    static bool isThreadLocalDestroyed () {
+        return threadLocalDestroyed();
+    }
+
+    static bool isPooled (const size_t pBytes, const size_t pAlignment) {
+        return pBytes <= (size_t(1) << MAX_CLASS_BITS)
+            && pAlignment <= alignof(std::max_align_t);
+    }
+
+    static size_t sizeClass (const size_t pBytes) {
+        size_t cls = 0;
+        while ((size_t(1) << (cls + MIN_CLASS_BITS)) < pBytes) {
+            ++cls;
+        }
+        return cls;
+    }
+
+    static size_t classSize (const size_t pClass) {
+        return size_t(1) << (pClass + MIN_CLASS_BITS);
+    }
+
+    void* allocate (const size_t pBytes, const size_t pAlignment) {
+        if (!isPooled(pBytes, pAlignment)) {
+            ++_stats.passedThrough;
+            return HeapAllocator().allocate(pBytes, pAlignment);
+        }
+        const size_t cls = sizeClass(pBytes);
+        if (FreeBlock *block = _freeLists[cls]) {
+            _freeLists[cls] = block->next;
+            --_classCounts[cls];
+            --_stats.cachedBlocks;
+            _stats.cachedBytes -= classSize(cls);
+            ++_stats.hits;
+            return block;
+        }
+        ++_stats.misses;
+        return HeapAllocator().allocate(classSize(cls), pAlignment);
+    }
+
+    void deallocate (void *pPtr, const size_t pBytes, const size_t pAlignment) {
+        if (!pPtr) {
+            return;
+        }
+        if (!isPooled(pBytes, pAlignment)) {
+            HeapAllocator().deallocate(pPtr, pBytes, pAlignment);
+            return;
+        }
+        const size_t cls = sizeClass(pBytes);
+        if (_classCounts[cls] >= _limits.maxBlocksPerClass
+            || _stats.cachedBytes + classSize(cls) > _limits.maxCachedBytes) {
+            ++_stats.released;
+            std::free(pPtr);
+            return;
+        }
+        FreeBlock *block = static_cast<FreeBlock*>(pPtr);
+        block->next = _freeLists[cls];
+        _freeLists[cls] = block;
+        ++_classCounts[cls];
+        ++_stats.cachedBlocks;
+        _stats.cachedBytes += classSize(cls);
+        ++_stats.recycled;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+    struct ThreadLocalPool;
+
+    // trivially destructible, so it is still readable after the pool is gone
+    static bool& threadLocalDestroyed () {
+        thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    Limits _limits;
+    SizeClassPoolStats _stats;
+    FreeBlock *_freeLists[CLASS_COUNT] = {};
+    size_t _classCounts[CLASS_COUNT] = {};
+};
+
+struct SizeClassPool::ThreadLocalPool {
+    ~ThreadLocalPool () {
+        threadLocalDestroyed() = true;
+    }
+
+    SizeClassPool pool;
+};
+
+inline SizeClassPool& SizeClassPool::threadLocal () {
+    thread_local ThreadLocalPool holder;
+    return holder.pool;
+}
+
+
+// SizeClassPool of the calling thread. Blocks are plain malloc() ones, so it
+// is fine for them to be freed on another thread (into that thread's pool).
+//
+// Once the thread's pool is destroyed at thread exit, blocks go straight to
+// HeapAllocator (malloc()/free()). Thread-local objects are destroyed before
+// static ones, so this is what a static SimpleVector<T, PoolAllocator> hits
+// when the program ends.
+class PoolAllocator {
+public:
+    void* allocate (const size_t pBytes, const size_t pAlignment) {
+        if (SizeClassPool::isThreadLocalDestroyed()) {
+            return HeapAllocator().allocate(pBytes, pAlignment);
+        }
+        return SizeClassPool::threadLocal().allocate(pBytes, pAlignment);
+    }
+
+    // stays in place while the new size fits into the same size class
+    void* reallocate (void *pPtr,
+                      const size_t pOldBytes,
+                      const size_t pNewBytes,
+                      const size_t pAlignment) {
+        if (SizeClassPool::isPooled(pOldBytes, pAlignment)
+            && SizeClassPool::isPooled(pNewBytes, pAlignment)
+            && SizeClassPool::sizeClass(pOldBytes)
+               == SizeClassPool::sizeClass(pNewBytes)) {
+            return pPtr;
+        }
+        return nullptr;
+    }
+
+    void deallocate (void *pPtr, const size_t pBytes, const size_t pAlignment) {
+        if (SizeClassPool::isThreadLocalDestroyed()) {
+            HeapAllocator().deallocate(pPtr, pBytes, pAlignment);
+            return;
+        }
+        SizeClassPool::threadLocal().deallocate(pPtr, pBytes, pAlignment);
+    }
+};
+
+} // namespace VcppBits
+
+#endif // VcppBits_SIMPLE_VECTOR_ALLOCATORS_HPP_INCLUDED__
@@ -0,0 +1,268 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_SIMPLE_VECTOR_CONCURRENT_VECTOR_HPP_INCLUDED__
+#define VcppBits_SIMPLE_VECTOR_CONCURRENT_VECTOR_HPP_INCLUDED__
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "VcppBits/SimpleVector/Allocators.hpp"
+#include "VcppBits/SimpleVector/SegmentIndex.hpp"
+
+namespace VcppBits {
+
+// Vector that any number of threads may push_back() into at once, without
+// locks. Slot is reserved with a fetch_add on the size, and elements live in
+// segments that are never moved, so references to elements stay valid while
+// others are appending.
+//
+// size() counts reserved slots, including ones that are still being
+// constructed by other threads. Read elements once the threads that pushed
+// them are synchronized with, e.g. joined. clear() and destruction are not
+// thread-safe.
+//
+// Each slot has a flag that is set once its element is constructed. If a
+// constructor throws, the slot stays reserved but empty: is_constructed()
+// tells so, iterators skip it and clear() doesn't destroy it.
+//
+// AllocatorT is called from all pushing threads, so it has to be
+// thread-safe (HeapAllocator is, BumpArena is not).
+template <typename T, typename AllocatorT = HeapAllocator>
+class ConcurrentVector {
+    using Index = detail::SegmentIndex<3>;
+public:
+    explicit ConcurrentVector (const AllocatorT &pAllocator = AllocatorT())
+        : _allocator (pAllocator) {
+    }
+
+    ~ConcurrentVector () {
+        clear();
+        for (size_t seg = 0; seg < Index::SEGMENT_COUNT; ++seg) {
+            if (T *segment = _segments[seg].load(std::memory_order_relaxed)) {
+                _allocator.deallocate(segment, segmentBytes(seg), alignof(T));
+            }
+        }
+    }
+
+    ConcurrentVector (const ConcurrentVector&) = delete;
+    ConcurrentVector& operator= (const ConcurrentVector&) = delete;
+
+    void push_back (const T &pElement) {
+        emplace_back(pElement);
+    }
+
+    void push_back (T &&pElement) {
+        emplace_back(std::move(pElement));
+    }
+
+    template <typename... Args>
+    T& emplace_back (Args&&... pArgs) {
+        const size_t index = _size.fetch_add(1, std::memory_order_relaxed);
+        const size_t seg = Index::segmentOf(index);
+        const size_t offset = Index::offsetIn(index, seg);
+        T *data = segment(seg);
+        T &res = *new (data + offset) T(std::forward<Args>(pArgs)...);
+        flags(data, seg)[offset].store(1, std::memory_order_release);
+        return res;
+    }
+
+    // allocates segments up front, so pushes up to pSize don't allocate
+    void reserve (const size_t pSize) {
+        if (pSize == 0) {
+            return;
+        }
+        const size_t last = Index::segmentOf(pSize - 1);
+        for (size_t seg = 0; seg <= last; ++seg) {
+            segment(seg);
+        }
+    }
+
+    size_t size () const {
+        return _size.load(std::memory_order_acquire);
+    }
+
+    // false for slots whose constructor threw or is still running
+    bool is_constructed (const size_t pNum) const {
+        const size_t seg = Index::segmentOf(pNum);
+        T *data = _segments[seg].load(std::memory_order_acquire);
+        return data
+            && flags(data, seg)[Index::offsetIn(pNum, seg)]
+                   .load(std::memory_order_acquire);
+    }
+
+    T& operator[] (const size_t pNum) {
+        const size_t seg = Index::segmentOf(pNum);
+        return _segments[seg].load(std::memory_order_acquire)
+            [Index::offsetIn(pNum, seg)];
+    }
+
+    const T& operator[] (const size_t pNum) const {
+        const size_t seg = Index::segmentOf(pNum);
+        return _segments[seg].load(std::memory_order_acquire)
+            [Index::offsetIn(pNum, seg)];
+    }
+
+    // destroys elements, keeps the segments
+    void clear () {
+        const size_t count = _size.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; ++i) {
+            const size_t seg = Index::segmentOf(i);
+            T *data = _segments[seg].load(std::memory_order_relaxed);
+            if (!data) {
+                // reserved by a push whose segment allocation threw
+                continue;
+            }
+            std::atomic<unsigned char> &flag =
+                flags(data, seg)[Index::offsetIn(i, seg)];
+            if (flag.load(std::memory_order_relaxed)) {
+                if constexpr (!std::is_trivially_destructible<T>::value) {
+                    data[Index::offsetIn(i, seg)].~T();
+                }
+                flag.store(0, std::memory_order_relaxed);
+            }
+        }
+        _size.store(0, std::memory_order_relaxed);
+    }
+
+    template <typename ValueT>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<ValueT>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueT*;
+        using reference = ValueT&;
+
+        Iterator (ConcurrentVector *pVector,
+                  const size_t pIndex,
+                  const size_t pEnd)
+            : _vector (pVector),
+              _index (pIndex),
+              _end (pEnd) {
+            skipEmpty();
+        }
+        Iterator& operator++ () {
+            ++_index;
+            skipEmpty();
+            return *this;
+        }
+        Iterator operator++ (int) {
+            Iterator res = *this;
+            ++*this;
+            return res;
+        }
+        bool operator== (const Iterator &pOther) const {
+            return _index == pOther._index;
+        }
+        bool operator!= (const Iterator &pOther) const {
+            return _index != pOther._index;
+        }
+        reference operator* () const {
+            return (*_vector)[_index];
+        }
+        pointer operator-> () const {
+            return &(*_vector)[_index];
+        }
+    private:
+        void skipEmpty () {
+            while (_index < _end && !_vector->is_constructed(_index)) {
+                ++_index;
+            }
+        }
+
+        ConcurrentVector *_vector;
+        size_t _index;
+        size_t _end;
+    };
+
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
+    iterator begin () { return iterator(this, 0, size()); }
+    iterator end () { return iterator(this, size(), size()); }
+    const_iterator begin () const {
+        return const_iterator(const_cast<ConcurrentVector*>(this),
+                              0,
+                              size());
+    }
+    const_iterator end () const {
+        return const_iterator(const_cast<ConcurrentVector*>(this),
+                              size(),
+                              size());
+    }
+
+private:
+    using Flag = std::atomic<unsigned char>;
+    static_assert(Flag::is_always_lock_free,
+                  "ConcurrentVector needs lock-free byte atomics");
+
+    // a segment's elements are followed by one constructed flag per slot
+    static size_t segmentBytes (const size_t pSegment) {
+        return Index::segmentSize(pSegment) * (sizeof(T) + sizeof(Flag));
+    }
+
+    static Flag* flags (T *pData, const size_t pSegment) {
+        return std::launder(reinterpret_cast<Flag*>(
+                                pData + Index::segmentSize(pSegment)));
+    }
+
+    // allocated on first use. Threads racing for a new segment all allocate
+    // one, the first to publish it wins and the rest give theirs back
+    T* segment (const size_t pSegment) {
+        std::atomic<T*> &slot = _segments[pSegment];
+        T *res = slot.load(std::memory_order_acquire);
+        if (res) {
+            return res;
+        }
+        const size_t bytes = segmentBytes(pSegment);
+        T *fresh = static_cast<T*>(_allocator.allocate(bytes, alignof(T)));
+        Flag *fresh_flags = reinterpret_cast<Flag*>(
+            fresh + Index::segmentSize(pSegment));
+        for (size_t i = 0; i < Index::segmentSize(pSegment); ++i) {
+            new (fresh_flags + i) Flag(0);
+        }
+        if (slot.compare_exchange_strong(res,
+                                         fresh,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+            return fresh;
+        }
+        _allocator.deallocate(fresh, bytes, alignof(T));
+        return res;
+    }
+
+    AllocatorT _allocator;
+    std::atomic<size_t> _size { 0 };
+    std::atomic<T*> _segments[Index::SEGMENT_COUNT] = {};
+};
+
+} // namespace VcppBits
+
+#endif // VcppBits_SIMPLE_VECTOR_CONCURRENT_VECTOR_HPP_INCLUDED__
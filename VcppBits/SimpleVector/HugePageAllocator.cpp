@@ -0,0 +1,176 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "VcppBits/SimpleVector/HugePageAllocator.hpp"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <new>
+
+namespace VcppBits {
+
+#if defined(__linux__)
+
+namespace {
+
+size_t mappedSize (const size_t pBytes) {
+    return detail::alignUp(pBytes, HugePageAllocator::HUGE_PAGE_SIZE);
+}
+
+// all mremap() promises about the address of a moved block
+size_t pageSize () {
+    static const size_t size = size_t(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+void adviseHugePages (void *pPtr, const size_t pSize) {
+    // fails with EINVAL when THP is not available, that's fine
+    (void) madvise(pPtr, pSize, MADV_HUGEPAGE);
+}
+
+} // namespace
+
+bool HugePageAllocator::isMapped (const size_t pBytes,
+                                  const size_t pAlignment) const {
+    return pBytes >= _threshold && pAlignment <= HUGE_PAGE_SIZE;
+}
+
+void* HugePageAllocator::allocate (const size_t pBytes,
+                                   const size_t pAlignment) {
+    if (!isMapped(pBytes, pAlignment)) {
+        return HeapAllocator().allocate(pBytes, pAlignment);
+    }
+
+    // over-map by a huge page and trim, so that the block starts on a huge
+    // page boundary
+    const size_t size = mappedSize(pBytes);
+    void *mapping = mmap(nullptr,
+                         size + HUGE_PAGE_SIZE,
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS,
+                         -1,
+                         0);
+    if (mapping == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    char *begin = static_cast<char*>(mapping);
+    char *aligned = reinterpret_cast<char*>(
+        detail::alignUp(reinterpret_cast<std::uintptr_t>(begin),
+                        HUGE_PAGE_SIZE));
+    if (aligned != begin) {
+        munmap(begin, size_t(aligned - begin));
+    }
+    const size_t tail = HUGE_PAGE_SIZE - size_t(aligned - begin);
+    if (tail) {
+        munmap(aligned + size, tail);
+    }
+
+    adviseHugePages(aligned, size);
+    return aligned;
+}
+
+void* HugePageAllocator::reallocate (void *pPtr,
+                                     const size_t pOldBytes,
+                                     const size_t pNewBytes,
+                                     const size_t pAlignment) {
+    const bool was_mapped = isMapped(pOldBytes, pAlignment);
+    if (was_mapped != isMapped(pNewBytes, pAlignment)) {
+        return nullptr;
+    }
+    if (!was_mapped) {
+        return HeapAllocator().reallocate(pPtr,
+                                          pOldBytes,
+                                          pNewBytes,
+                                          pAlignment);
+    }
+
+    const size_t old_size = mappedSize(pOldBytes);
+    const size_t new_size = mappedSize(pNewBytes);
+    if (old_size == new_size) {
+        return pPtr;
+    }
+    // a moved block could break stricter alignment, let the caller relocate
+    // it to a fresh allocate()d one
+    if (pAlignment > pageSize()) {
+        return nullptr;
+    }
+    // the kernel moves page tables rather than data. A moved block may lose
+    // the huge page alignment, in which case only its aligned middle part
+    // can use huge pages
+    void *res = mremap(pPtr, old_size, new_size, MREMAP_MAYMOVE);
+    if (res == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    adviseHugePages(res, new_size);
+    return res;
+}
+
+void HugePageAllocator::deallocate (void *pPtr,
+                                    const size_t pBytes,
+                                    const size_t pAlignment) {
+    if (!isMapped(pBytes, pAlignment)) {
+        HeapAllocator().deallocate(pPtr, pBytes, pAlignment);
+        return;
+    }
+    if (pPtr) {
+        munmap(pPtr, mappedSize(pBytes));
+    }
+}
+
+#else // no mmap()/THP, everything goes to the heap
+
+bool HugePageAllocator::isMapped (const size_t, const size_t) const {
+    return false;
+}
+
+void* HugePageAllocator::allocate (const size_t pBytes,
+                                   const size_t pAlignment) {
+    return HeapAllocator().allocate(pBytes, pAlignment);
+}
+
+void* HugePageAllocator::reallocate (void *pPtr,
+                                     const size_t pOldBytes,
+                                     const size_t pNewBytes,
+                                     const size_t pAlignment) {
+    return HeapAllocator().reallocate(pPtr, pOldBytes, pNewBytes, pAlignment);
+}
+
+void HugePageAllocator::deallocate (void *pPtr,
+                                    const size_t pBytes,
+                                    const size_t pAlignment) {
+    HeapAllocator().deallocate(pPtr, pBytes, pAlignment);
+}
+
+#endif
+
+} // namespace VcppBits
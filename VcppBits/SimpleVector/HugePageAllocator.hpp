@@ -0,0 +1,70 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_SIMPLE_VECTOR_HUGE_PAGE_ALLOCATOR_HPP_INCLUDED__
+#define VcppBits_SIMPLE_VECTOR_HUGE_PAGE_ALLOCATOR_HPP_INCLUDED__
+
+#include <cstddef>
+
+#include "VcppBits/SimpleVector/Allocators.hpp"
+
+namespace VcppBits {
+
+// Blocks of pThreshold bytes and more are anonymous mmap()ings aligned to
+// 2 MiB and advised with MADV_HUGEPAGE, so big tables can be backed by
+// transparent huge pages and take fewer TLB misses. Growing them goes
+// through mremap(), without copying, unless the alignment asked for is
+// above the page size, which a moved mapping doesn't keep. If THP is disabled the advice is just
+// ignored and these are normal mappings. Smaller blocks, and everything on
+// platforms other than Linux, go to HeapAllocator.
+class HugePageAllocator {
+public:
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) * 1024 * 1024;
+    static constexpr size_t DEFAULT_THRESHOLD = HUGE_PAGE_SIZE;
+
+    explicit HugePageAllocator (const size_t pThreshold = DEFAULT_THRESHOLD)
+        : _threshold (pThreshold) {
+    }
+
+    void* allocate (const size_t pBytes, const size_t pAlignment);
+    void* reallocate (void *pPtr,
+                      const size_t pOldBytes,
+                      const size_t pNewBytes,
+                      const size_t pAlignment);
+    void deallocate (void *pPtr, const size_t pBytes, const size_t pAlignment);
+
+    bool isMapped (const size_t pBytes, const size_t pAlignment) const;
+
+    size_t getThreshold () const {
+        return _threshold;
+    }
+
+private:
+    size_t _threshold;
+};
+
+} // namespace VcppBits
+
+#endif // VcppBits_SIMPLE_VECTOR_HUGE_PAGE_ALLOCATOR_HPP_INCLUDED__
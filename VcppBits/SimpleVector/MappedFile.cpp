@@ -0,0 +1,282 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "VcppBits/SimpleVector/MappedFile.hpp"
+
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define VcppBits_MAPPED_FILE_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace VcppBits {
+
+namespace {
+
+[[noreturn]] void throwErrno (const char *pWhat) {
+    throw std::system_error(errno, std::generic_category(), pWhat);
+}
+
+} // namespace
+
+MappedFile::MappedFile (MappedFile &&pOther)
+    : _fd (std::exchange(pOther._fd, -1)),
+      _data (std::exchange(pOther._data, nullptr)),
+      _size (std::exchange(pOther._size, 0)),
+      _wasCreated (pOther._wasCreated),
+      _sharedName (std::move(pOther._sharedName)) {
+    pOther._sharedName.clear();
+}
+
+MappedFile& MappedFile::operator= (MappedFile &&pOther) {
+    if (this != &pOther) {
+        close();
+        _fd = std::exchange(pOther._fd, -1);
+        _data = std::exchange(pOther._data, nullptr);
+        _size = std::exchange(pOther._size, 0);
+        _wasCreated = pOther._wasCreated;
+        _sharedName = std::move(pOther._sharedName);
+        pOther._sharedName.clear();
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile () {
+    close();
+}
+
+#ifdef VcppBits_MAPPED_FILE_POSIX
+
+namespace {
+
+// shared memory may be in use by a live owner, so CREATE_NEW refuses to take
+// it over instead of truncating it under the processes that have it mapped
+int openFlags (const MappedFile::OpenMode pMode, const bool pShared) {
+    int flags = O_RDWR;
+    if (pMode == MappedFile::OpenMode::CREATE_NEW) {
+        flags |= O_CREAT | (pShared ? O_EXCL : O_TRUNC);
+    }
+    else if (pMode == MappedFile::OpenMode::OPEN_OR_CREATE) {
+        flags |= O_CREAT;
+    }
+    return flags;
+}
+
+size_t fileSize (const int pFd) {
+    struct stat st;
+    if (fstat(pFd, &st) != 0) {
+        throwErrno("MappedFile: fstat failed");
+    }
+    return size_t(st.st_size);
+}
+
+} // namespace
+
+MappedFile::MappedFile (const std::string &pPath,
+                        const OpenMode pMode,
+                        const size_t pInitialSize) {
+    const int fd = ::open(pPath.c_str(), openFlags(pMode, false), 0644);
+    if (fd < 0) {
+        throwErrno("MappedFile: can't open file");
+    }
+    open(fd, pMode, pInitialSize);
+}
+
+MappedFile MappedFile::shared (const std::string &pName,
+                               const OpenMode pMode,
+                               const size_t pInitialSize) {
+    const int fd = shm_open(pName.c_str(), openFlags(pMode, true), 0600);
+    if (fd < 0) {
+        throwErrno("MappedFile: can't open shared memory");
+    }
+    MappedFile res;
+    res.open(fd, pMode, pInitialSize);
+    if (pMode == OpenMode::CREATE_NEW) {
+        res._sharedName = pName;
+    }
+    return res;
+}
+
+void MappedFile::unlinkShared (const std::string &pName) {
+    if (shm_unlink(pName.c_str()) != 0 && errno != ENOENT) {
+        throwErrno("MappedFile: shm_unlink failed");
+    }
+}
+
+void MappedFile::open (const int pFd,
+                       const OpenMode pMode,
+                       const size_t pInitialSize) {
+    _fd = pFd;
+    try {
+        size_t size = fileSize(_fd);
+        // an existing empty file is only extended if we may create it
+        if (size == 0 && pMode != OpenMode::OPEN_EXISTING) {
+            _wasCreated = true;
+            size = pInitialSize;
+            if (ftruncate(_fd, off_t(size)) != 0) {
+                throwErrno("MappedFile: ftruncate failed");
+            }
+        }
+        map(size);
+    }
+    catch (...) {
+        close();
+        throw;
+    }
+}
+
+void MappedFile::map (const size_t pSize) {
+    if (pSize == 0) {
+        _data = nullptr;
+        _size = 0;
+        return;
+    }
+    void *ptr = mmap(nullptr,
+                     pSize,
+                     PROT_READ | PROT_WRITE,
+                     MAP_SHARED,
+                     _fd,
+                     0);
+    if (ptr == MAP_FAILED) {
+        throwErrno("MappedFile: mmap failed");
+    }
+    _data = static_cast<char*>(ptr);
+    _size = pSize;
+}
+
+void MappedFile::remap (const size_t pSize) {
+#if defined(__linux__)
+    if (_data && pSize) {
+        void *ptr = mremap(_data, _size, pSize, MREMAP_MAYMOVE);
+        if (ptr == MAP_FAILED) {
+            throwErrno("MappedFile: mremap failed");
+        }
+        _data = static_cast<char*>(ptr);
+        _size = pSize;
+        return;
+    }
+#endif
+    if (_data) {
+        munmap(_data, _size);
+        _data = nullptr;
+        _size = 0;
+    }
+    map(pSize);
+}
+
+void MappedFile::resize (const size_t pSize) {
+    if (!isOpen()) {
+        throw std::logic_error("MappedFile: not open");
+    }
+    if (ftruncate(_fd, off_t(pSize)) != 0) {
+        throwErrno("MappedFile: ftruncate failed");
+    }
+    remap(pSize);
+}
+
+void MappedFile::refresh () {
+    if (!isOpen()) {
+        throw std::logic_error("MappedFile: not open");
+    }
+    const size_t size = fileSize(_fd);
+    if (size != _size) {
+        remap(size);
+    }
+}
+
+void MappedFile::sync (const bool pAsync) {
+    if (_data && msync(_data, _size, pAsync ? MS_ASYNC : MS_SYNC) != 0) {
+        throwErrno("MappedFile: msync failed");
+    }
+}
+
+void MappedFile::close () {
+    if (_data) {
+        munmap(_data, _size);
+        _data = nullptr;
+        _size = 0;
+    }
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+    if (!_sharedName.empty()) {
+        shm_unlink(_sharedName.c_str());
+        _sharedName.clear();
+    }
+}
+
+#else
+
+MappedFile::MappedFile (const std::string&, const OpenMode, const size_t) {
+    throw std::runtime_error("MappedFile: not supported on this platform");
+}
+
+MappedFile MappedFile::shared (const std::string&,
+                               const OpenMode,
+                               const size_t) {
+    throw std::runtime_error("MappedFile: not supported on this platform");
+}
+
+void MappedFile::unlinkShared (const std::string&) {
+}
+
+void MappedFile::open (const int, const OpenMode, const size_t) {
+}
+
+void MappedFile::map (const size_t) {
+}
+
+void MappedFile::remap (const size_t) {
+}
+
+void MappedFile::resize (const size_t) {
+    throw std::logic_error("MappedFile: not open");
+}
+
+void MappedFile::refresh () {
+    throw std::logic_error("MappedFile: not open");
+}
+
+void MappedFile::sync (const bool) {
+}
+
+void MappedFile::close () {
+}
+
+#endif
+
+} // namespace VcppBits
@@ -0,0 +1,116 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_SIMPLE_VECTOR_MAPPED_FILE_HPP_INCLUDED__
+#define VcppBits_SIMPLE_VECTOR_MAPPED_FILE_HPP_INCLUDED__
+
+#include <cstddef>
+#include <string>
+
+namespace VcppBits {
+
+// Whole file mapped read-write and shared, so changes go to the file. Only
+// available on POSIX systems, elsewhere the constructor throws.
+//
+// shared() does the same for a POSIX shared memory object, for buffers
+// shared by processes on one machine.
+//
+// OS errors are thrown as std::system_error
+class MappedFile {
+public:
+    enum class OpenMode {
+        OPEN_EXISTING,
+        // truncates an existing file; for shared() an existing object is
+        // an error (EEXIST) instead, see unlinkShared()
+        CREATE_NEW,
+        OPEN_OR_CREATE
+    };
+
+    MappedFile () = default;
+    // an empty or new file is extended to pInitialSize
+    MappedFile (const std::string &pPath,
+                const OpenMode pMode,
+                const size_t pInitialSize);
+    ~MappedFile ();
+
+    MappedFile (const MappedFile&) = delete;
+    MappedFile& operator= (const MappedFile&) = delete;
+    MappedFile (MappedFile &&pOther);
+    MappedFile& operator= (MappedFile &&pOther);
+
+    // shm_open() instead of open(), pName is like "/my_buffer". The object
+    // is unlinked when the MappedFile made with CREATE_NEW is closed;
+    // processes that have it mapped keep using it. CREATE_NEW throws if the
+    // name is taken, so a live owner's object is never truncated
+    static MappedFile shared (const std::string &pName,
+                              const OpenMode pMode,
+                              const size_t pInitialSize);
+    // for objects left over by crashed owners
+    static void unlinkShared (const std::string &pName);
+
+    // ftruncate() and remap, data() may change
+    void resize (const size_t pSize);
+
+    // remap if the file was resized by someone else, data() may change
+    void refresh ();
+
+    // msync(), blocks until the data is written unless pAsync
+    void sync (const bool pAsync = false);
+
+    char* data () const {
+        return _data;
+    }
+
+    size_t size () const {
+        return _size;
+    }
+
+    bool isOpen () const {
+        return _fd >= 0;
+    }
+
+    // true if the file was new or empty when opened
+    bool wasCreated () const {
+        return _wasCreated;
+    }
+
+    void close ();
+
+private:
+    void open (const int pFd, const OpenMode pMode, const size_t pInitialSize);
+    void map (const size_t pSize);
+    void remap (const size_t pSize);
+
+    int _fd = -1;
+    char *_data = nullptr;
+    size_t _size = 0;
+    bool _wasCreated = false;
+    // set for the owner of a shared memory object, which unlinks it
+    std::string _sharedName;
+};
+
+} // namespace VcppBits
+
+#endif // VcppBits_SIMPLE_VECTOR_MAPPED_FILE_HPP_INCLUDED__
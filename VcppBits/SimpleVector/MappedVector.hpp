@@ -0,0 +1,251 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_SIMPLE_VECTOR_MAPPED_VECTOR_HPP_INCLUDED__
+#define VcppBits_SIMPLE_VECTOR_MAPPED_VECTOR_HPP_INCLUDED__
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "VcppBits/SimpleVector/MappedFile.hpp"
+#include "VcppBits/SimpleVector/SimpleVector.hpp"
+
+namespace VcppBits {
+
+// first 64 bytes of a MappedVector file, elements follow. Size and capacity
+// are atomics, as other processes may read them while the writer updates
+// them; they have to be lock-free to work across address spaces
+struct MappedVectorHeader {
+    static constexpr char MAGIC[8] = { 'V', 'c', 'p', 'p', 'V', 'e', 'c', '1' };
+
+    char magic[8];
+    std::uint32_t headerSize;
+    std::uint32_t elementSize;
+    std::atomic<std::uint64_t> size;
+    std::atomic<std::uint64_t> capacity;
+    char reserved[32];
+};
+static_assert(sizeof(MappedVectorHeader) == 64,
+              "MappedVectorHeader: unexpected padding");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "MappedVectorHeader: 64-bit atomics aren't lock-free");
+
+
+// SimpleVector-like container kept in a memory-mapped file. It is a
+// SimpleVector view over the mapping, re-pointed whenever the file is
+// extended (ftruncate() and remap). Opening an existing file needs no
+// deserialization, elements are used right where they are.
+//
+// The file is in the native byte order and layout of T, so only reopen it
+// with the same T on the same kind of machine. Size is kept in the header
+// on every change; flush() makes sure it has reached the disk.
+//
+// openShared() puts it into POSIX shared memory instead. One process writes,
+// any number of others attach to the same name and read; their refresh()
+// picks up elements added since, remapping if the writer has grown the
+// buffer. An element is complete once it is counted by the header size,
+// which the writer updates with release semantics after writing it.
+template <typename T>
+class MappedVector {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "MappedVector: T must be trivially copyable");
+    static_assert(alignof(T) <= sizeof(MappedVectorHeader),
+                  "MappedVector: T is over-aligned");
+public:
+    using OpenMode = MappedFile::OpenMode;
+
+    explicit MappedVector (const std::string &pPath,
+                           const OpenMode pMode = OpenMode::OPEN_OR_CREATE,
+                           const size_t pInitialCapacity = 0)
+        : MappedVector (MappedFile(pPath, pMode, bytesFor(pInitialCapacity)),
+                        pPath,
+                        pInitialCapacity) {
+    }
+
+    // pName is a shared memory object name, like "/frames". Creator with
+    // OpenMode::CREATE_NEW owns it: it is unlinked when that vector is gone
+    static MappedVector openShared (const std::string &pName,
+                                    const OpenMode pMode,
+                                    const size_t pInitialCapacity = 0) {
+        return MappedVector(MappedFile::shared(pName,
+                                               pMode,
+                                               bytesFor(pInitialCapacity)),
+                            pName,
+                            pInitialCapacity);
+    }
+
+    MappedVector (MappedVector&&) = default;
+    MappedVector& operator= (MappedVector&&) = default;
+
+    // for readers: take up size and capacity changes made by the writer
+    void refresh () {
+        if (bytesFor(loadCapacity()) > _file.size()) {
+            _file.refresh();
+        }
+        attach();
+    }
+
+    size_t size () const {
+        return _view.size();
+    }
+
+    size_t capacity () const {
+        return _view.capacity();
+    }
+
+    T* data () const {
+        return _view.data();
+    }
+
+    T& operator[] (const size_t pNum) {
+        return _view[pNum];
+    }
+
+    const T& operator[] (const size_t pNum) const {
+        return _view[pNum];
+    }
+
+    T* begin () { return _view.begin(); }
+    T* end () { return _view.end(); }
+    const T* begin () const { return _view.begin(); }
+    const T* end () const { return _view.end(); }
+
+    void push_back (const T &pElement) {
+        if (size() == capacity()) {
+            // pElement may live in the mapping that is about to move
+            const T copy = pElement;
+            reserve(std::max<size_t>(8, capacity() * 2));
+            _view.push_back(copy);
+        }
+        else {
+            _view.push_back(pElement);
+        }
+        storeSize();
+    }
+
+    void resize (const size_t pSize) {
+        reserve(pSize);
+        _view.resize(pSize);
+        storeSize();
+    }
+
+    void reserve (const size_t pCapacity) {
+        if (pCapacity <= capacity()) {
+            return;
+        }
+        _file.resize(bytesFor(pCapacity));
+        header().capacity.store(pCapacity, std::memory_order_release);
+        attach();
+    }
+
+    void clear () {
+        _view.nullify();
+        storeSize();
+    }
+
+    void flush (const bool pAsync = false) {
+        _file.sync(pAsync);
+    }
+
+private:
+    MappedVector (MappedFile &&pFile,
+                  const std::string &pName,
+                  const size_t pInitialCapacity)
+        : _file (std::move(pFile)) {
+        if (_file.wasCreated()) {
+            MappedVectorHeader &h = header();
+            std::memcpy(h.magic, MappedVectorHeader::MAGIC, sizeof(h.magic));
+            h.headerSize = sizeof(MappedVectorHeader);
+            h.elementSize = sizeof(T);
+            h.size.store(0, std::memory_order_relaxed);
+            h.capacity.store(pInitialCapacity, std::memory_order_release);
+        }
+        else {
+            validateHeader(pName);
+        }
+        attach();
+    }
+
+    static size_t bytesFor (const size_t pCapacity) {
+        return sizeof(MappedVectorHeader) + pCapacity * sizeof(T);
+    }
+
+    MappedVectorHeader& header () {
+        return *reinterpret_cast<MappedVectorHeader*>(_file.data());
+    }
+
+    void validateHeader (const std::string &pPath) {
+        if (_file.size() < sizeof(MappedVectorHeader)) {
+            throw std::runtime_error("MappedVector: " + pPath
+                                     + " is too small");
+        }
+        const MappedVectorHeader &h = header();
+        if (std::memcmp(h.magic, MappedVectorHeader::MAGIC, sizeof(h.magic))
+            || h.headerSize != sizeof(MappedVectorHeader)
+            || h.elementSize != sizeof(T)
+            || loadSize() > loadCapacity()
+            || bytesFor(loadCapacity()) > _file.size()) {
+            throw std::runtime_error("MappedVector: " + pPath
+                                     + " is not a vector of this type");
+        }
+    }
+
+    size_t loadSize () {
+        return size_t(header().size.load(std::memory_order_acquire));
+    }
+
+    size_t loadCapacity () {
+        return size_t(header().capacity.load(std::memory_order_acquire));
+    }
+
+    // elements are written by now
+    void storeSize () {
+        header().size.store(size(), std::memory_order_release);
+    }
+
+    void attach () {
+        // capacity first: size never exceeds the capacity seen before it.
+        // Writer may have grown it again since our mapping was made
+        const size_t mapped =
+            (_file.size() - sizeof(MappedVectorHeader)) / sizeof(T);
+        const size_t capacity = std::min(loadCapacity(), mapped);
+        _view.initializeByMemory(
+            reinterpret_cast<T*>(_file.data() + sizeof(MappedVectorHeader)),
+            capacity,
+            std::min(loadSize(), capacity));
+    }
+
+    MappedFile _file;
+    SimpleVector<T> _view;
+};
+
+} // namespace VcppBits
+
+#endif // VcppBits_SIMPLE_VECTOR_MAPPED_VECTOR_HPP_INCLUDED__
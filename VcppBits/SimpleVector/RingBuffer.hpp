@@ -0,0 +1,335 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_SIMPLE_VECTOR_RING_BUFFER_HPP_INCLUDED__
+#define VcppBits_SIMPLE_VECTOR_RING_BUFFER_HPP_INCLUDED__
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "VcppBits/SimpleVector/Allocators.hpp"
+#include "VcppBits/SimpleVector/SimpleVector.hpp"
+
+namespace VcppBits {
+
+namespace detail {
+
+// uninitialized room for one T, RingBuffer constructs elements itself
+template <typename T>
+struct RingSlot {
+    alignas(T) unsigned char bytes[sizeof(T)];
+};
+
+} // namespace detail
+
+
+// Double-ended queue over a power-of-two array: push/pop at both ends are
+// O(1), and positions wrap around with a mask. Contents are at most two
+// contiguous runs, see firstSpan()/secondSpan(), e.g. for bulk memcpy.
+//
+// When full, it either grows (elements are moved to a twice bigger array) or
+// overwrites the element at the opposite end, which suits fixed-size
+// histories. Storage is a SimpleVector, so the same allocators apply and
+// growth shows up in its stats and callbacks, and initializeByMemory() runs
+// it over a foreign buffer.
+template <typename T, typename AllocatorT = HeapAllocator>
+class RingBuffer {
+    using Slot = detail::RingSlot<T>;
+public:
+    enum class Overflow {
+        GROW,
+        OVERWRITE
+    };
+
+    using Span = std::pair<T*, size_t>;
+    using ConstSpan = std::pair<const T*, size_t>;
+
+    // pCapacity is rounded up to a power of two
+    explicit RingBuffer (const size_t pCapacity = 0,
+                         const Overflow pOverflow = Overflow::GROW,
+                         const AllocatorT &pAllocator = AllocatorT())
+        : _slots (pAllocator),
+          _overflow (pOverflow) {
+        if (pCapacity) {
+            reallocate(roundUp(pCapacity));
+        }
+    }
+
+    ~RingBuffer () {
+        clear();
+    }
+
+    RingBuffer (const RingBuffer&) = delete;
+    RingBuffer& operator= (const RingBuffer&) = delete;
+
+    RingBuffer (RingBuffer &&pOther)
+        : _slots (std::move(pOther._slots)),
+          _overflow (pOther._overflow),
+          _head (std::exchange(pOther._head, 0)),
+          _size (std::exchange(pOther._size, 0)),
+          _mask (std::exchange(pOther._mask, 0)),
+          _isView (std::exchange(pOther._isView, false)) {
+    }
+
+    RingBuffer& operator= (RingBuffer &&pOther) {
+        if (this != &pOther) {
+            clear();
+            _slots = std::move(pOther._slots);
+            _overflow = pOther._overflow;
+            _head = std::exchange(pOther._head, 0);
+            _size = std::exchange(pOther._size, 0);
+            _mask = std::exchange(pOther._mask, 0);
+            _isView = std::exchange(pOther._isView, false);
+        }
+        return *this;
+    }
+
+    // runs over pCapacity elements at pMemory (a power of two). Foreign
+    // memory can't grow, so the buffer switches to Overflow::OVERWRITE and
+    // reserve() beyond pCapacity throws
+    void initializeByMemory (T *pMemory, const size_t pCapacity) {
+        if (pCapacity == 0 || (pCapacity & (pCapacity - 1))) {
+            throw std::invalid_argument(
+                "RingBuffer: capacity must be a power of two");
+        }
+        clear();
+        _slots.initializeByMemory(reinterpret_cast<Slot*>(pMemory),
+                                  pCapacity,
+                                  pCapacity);
+        _head = 0;
+        _mask = pCapacity - 1;
+        _overflow = Overflow::OVERWRITE;
+        _isView = true;
+    }
+
+    size_t size () const {
+        return _size;
+    }
+
+    size_t capacity () const {
+        return _slots.size();
+    }
+
+    bool empty () const {
+        return _size == 0;
+    }
+
+    bool full () const {
+        return _size == capacity();
+    }
+
+    void push_back (const T &pElement) {
+        emplace_back(pElement);
+    }
+
+    void push_back (T &&pElement) {
+        emplace_back(std::move(pElement));
+    }
+
+    void push_front (const T &pElement) {
+        emplace_front(pElement);
+    }
+
+    void push_front (T &&pElement) {
+        emplace_front(std::move(pElement));
+    }
+
+    template <typename... Args>
+    T& emplace_back (Args&&... pArgs) {
+        if (full()) {
+            // pArgs may refer to our own elements, including the one that is
+            // about to be overwritten
+            T element(std::forward<Args>(pArgs)...);
+            makeRoom(true);
+            return *new (slot(_size++)) T(std::move(element));
+        }
+        return *new (slot(_size++)) T(std::forward<Args>(pArgs)...);
+    }
+
+    template <typename... Args>
+    T& emplace_front (Args&&... pArgs) {
+        if (full()) {
+            T element(std::forward<Args>(pArgs)...);
+            makeRoom(false);
+            _head = (_head - 1) & _mask;
+            ++_size;
+            return *new (slot(0)) T(std::move(element));
+        }
+        _head = (_head - 1) & _mask;
+        ++_size;
+        return *new (slot(0)) T(std::forward<Args>(pArgs)...);
+    }
+
+    void pop_front () {
+        front().~T();
+        _head = (_head + 1) & _mask;
+        --_size;
+    }
+
+    void pop_back () {
+        back().~T();
+        --_size;
+    }
+
+    T& front () { return (*this)[0]; }
+    const T& front () const { return (*this)[0]; }
+    T& back () { return (*this)[_size - 1]; }
+    const T& back () const { return (*this)[_size - 1]; }
+
+    // 0 is the front
+    T& operator[] (const size_t pNum) {
+        return *slot(pNum);
+    }
+
+    const T& operator[] (const size_t pNum) const {
+        return *slot(pNum);
+    }
+
+    // elements from the front up to the end of the array, and the ones that
+    // wrapped around to its beginning. Either may be empty
+    Span firstSpan () {
+        return Span(slot(0), firstSpanSize());
+    }
+
+    Span secondSpan () {
+        return Span(rawSlot(0), _size - firstSpanSize());
+    }
+
+    ConstSpan firstSpan () const {
+        return ConstSpan(slot(0), firstSpanSize());
+    }
+
+    ConstSpan secondSpan () const {
+        return ConstSpan(rawSlot(0), _size - firstSpanSize());
+    }
+
+    void clear () {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = 0; i < _size; ++i) {
+                (*this)[i].~T();
+            }
+        }
+        _size = 0;
+        _head = 0;
+    }
+
+    void reserve (const size_t pCapacity) {
+        if (pCapacity > capacity()) {
+            if (_isView) {
+                throw std::logic_error(
+                    "RingBuffer: can't grow over foreign memory");
+            }
+            reallocate(roundUp(pCapacity));
+        }
+    }
+
+private:
+    // for a full buffer: drops the element at the other end, or grows
+    void makeRoom (const bool pAtBack) {
+        if (_overflow == Overflow::OVERWRITE && _size) {
+            if (pAtBack) {
+                pop_front();
+            }
+            else {
+                pop_back();
+            }
+        }
+        else {
+            reallocate(roundUp(std::max<size_t>(8, capacity() + 1)));
+        }
+    }
+
+    static size_t roundUp (const size_t pCapacity) {
+        if (pCapacity > std::numeric_limits<size_t>::max() / 2 + 1) {
+            throw std::length_error("RingBuffer: capacity is too big");
+        }
+        size_t res = 1;
+        while (res < pCapacity) {
+            res *= 2;
+        }
+        return res;
+    }
+
+    T* rawSlot (const size_t pPosition) const {
+        return reinterpret_cast<T*>(_slots.data() + pPosition);
+    }
+
+    T* slot (const size_t pNum) const {
+        return rawSlot((_head + pNum) & _mask);
+    }
+
+    size_t firstSpanSize () const {
+        return std::min(_size, capacity() - _head);
+    }
+
+    // moves elements to a new array of pCapacity, unwrapped. Goes through
+    // SimpleVector::grow(), so growth stats and callbacks see it. Elements
+    // are copied if their move can throw, and the old ones are destroyed
+    // only once all are in place, so a throw leaves the buffer as it was
+    void reallocate (const size_t pCapacity) {
+        SimpleVector<Slot, AllocatorT> slots(_slots.get_allocator());
+        slots.grow(pCapacity);
+        slots.resize(pCapacity);
+        T *to = reinterpret_cast<T*>(slots.data());
+        size_t constructed = 0;
+        try {
+            for (; constructed < _size; ++constructed) {
+                new (to + constructed)
+                    T(std::move_if_noexcept((*this)[constructed]));
+            }
+        }
+        catch (...) {
+            for (size_t i = 0; i < constructed; ++i) {
+                to[i].~T();
+            }
+            throw;
+        }
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = 0; i < _size; ++i) {
+                (*this)[i].~T();
+            }
+        }
+        _slots = std::move(slots);
+        _head = 0;
+        _mask = pCapacity - 1;
+    }
+
+    SimpleVector<Slot, AllocatorT> _slots;
+    Overflow _overflow;
+    size_t _head = 0;
+    size_t _size = 0;
+    size_t _mask = 0;
+    // over initializeByMemory() storage
+    bool _isView = false;
+};
+
+} // namespace VcppBits
+
+#endif // VcppBits_SIMPLE_VECTOR_RING_BUFFER_HPP_INCLUDED__
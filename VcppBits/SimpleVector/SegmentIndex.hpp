@@ -0,0 +1,88 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_SIMPLE_VECTOR_SEGMENT_INDEX_HPP_INCLUDED__
+#define VcppBits_SIMPLE_VECTOR_SEGMENT_INDEX_HPP_INCLUDED__
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace VcppBits {
+namespace detail {
+
+// pValue must not be 0
+inline size_t floorLog2 (const size_t pValue) {
+#ifdef _MSC_VER
+    unsigned long res;
+#ifdef _WIN64
+    _BitScanReverse64(&res, pValue);
+#else
+    _BitScanReverse(&res, pValue);
+#endif
+    return size_t(res);
+#else
+    // clzll counts over 64 bits whatever the width of size_t
+    return 63 - size_t(__builtin_clzll(std::uint64_t(pValue)));
+#endif
+}
+
+// Index math for containers built of segments that are never moved:
+// segment 0 holds 2^FirstBitsV elements, and each next one is twice as big as
+// the one before, so any index maps to its segment with a couple of
+// instructions and the total size doubles with each segment, like a vector
+template <size_t FirstBitsV>
+struct SegmentIndex {
+    static constexpr size_t FIRST_SEGMENT_SIZE = size_t(1) << FirstBitsV;
+    // enough to address the whole size_t range
+    static constexpr size_t SEGMENT_COUNT =
+        sizeof(size_t) * CHAR_BIT - FirstBitsV;
+
+    static size_t segmentOf (const size_t pIndex) {
+        return floorLog2(pIndex + FIRST_SEGMENT_SIZE) - FirstBitsV;
+    }
+
+    static constexpr size_t segmentSize (const size_t pSegment) {
+        return FIRST_SEGMENT_SIZE << pSegment;
+    }
+
+    // index of the first element of pSegment
+    static constexpr size_t segmentStart (const size_t pSegment) {
+        return segmentSize(pSegment) - FIRST_SEGMENT_SIZE;
+    }
+
+    static size_t offsetIn (const size_t pIndex, const size_t pSegment) {
+        return pIndex - segmentStart(pSegment);
+    }
+};
+
+} // namespace detail
+} // namespace VcppBits
+
+#endif // VcppBits_SIMPLE_VECTOR_SEGMENT_INDEX_HPP_INCLUDED__
@@ -0,0 +1,239 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_SIMPLE_VECTOR_SEGMENTED_VECTOR_HPP_INCLUDED__
+#define VcppBits_SIMPLE_VECTOR_SEGMENTED_VECTOR_HPP_INCLUDED__
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "VcppBits/SimpleVector/Allocators.hpp"
+#include "VcppBits/SimpleVector/SegmentIndex.hpp"
+#include "VcppBits/SimpleVector/SimpleVector.hpp"
+
+namespace VcppBits {
+
+// Vector with SimpleVector's push_back()/operator[]/iteration, that never
+// moves its elements. Storage is a list of segments of 8, 16, 32... elements;
+// growth adds a segment and copies nothing, and pointers to elements stay
+// valid for as long as the elements exist. Indexing is a bit scan and two
+// loads instead of one.
+template <typename T, typename AllocatorT = HeapAllocator>
+class SegmentedVector {
+    using Index = detail::SegmentIndex<3>;
+public:
+    explicit SegmentedVector (const AllocatorT &pAllocator = AllocatorT())
+        : _allocator (pAllocator) {
+    }
+
+    ~SegmentedVector () {
+        release();
+    }
+
+    SegmentedVector (const SegmentedVector&) = delete;
+    SegmentedVector& operator= (const SegmentedVector&) = delete;
+
+    SegmentedVector (SegmentedVector &&pOther)
+        : _allocator (std::move(pOther._allocator)),
+          _segments (std::move(pOther._segments)),
+          _used_size (std::exchange(pOther._used_size, 0)) {
+    }
+
+    SegmentedVector& operator= (SegmentedVector &&pOther) {
+        if (this != &pOther) {
+            release();
+            _allocator = std::move(pOther._allocator);
+            _segments = std::move(pOther._segments);
+            _used_size = std::exchange(pOther._used_size, 0);
+        }
+        return *this;
+    }
+
+    size_t size () const {
+        return _used_size;
+    }
+
+    size_t capacity () const {
+        return Index::segmentStart(_segments.size());
+    }
+
+    void reserve (const size_t pSize) {
+        while (capacity() < pSize) {
+            const size_t seg = _segments.size();
+            _segments.push_back(static_cast<T*>(
+                _allocator.allocate(Index::segmentSize(seg) * sizeof(T),
+                                    alignof(T))));
+        }
+    }
+
+    // new elements are default-initialized, like in SimpleVector
+    void resize (const size_t pSize) {
+        reserve(pSize);
+        for (size_t i = _used_size; i < pSize; ++i) {
+            new (&(*this)[i]) T;
+        }
+        destroy(pSize, _used_size);
+        _used_size = pSize;
+    }
+
+    void nullify () {
+        destroy(0, _used_size);
+        _used_size = 0;
+    }
+
+    T& operator[] (const size_t pNum) {
+        const size_t seg = Index::segmentOf(pNum);
+        return _segments[seg][Index::offsetIn(pNum, seg)];
+    }
+
+    const T& operator[] (const size_t pNum) const {
+        const size_t seg = Index::segmentOf(pNum);
+        return _segments[seg][Index::offsetIn(pNum, seg)];
+    }
+
+    void push_back (const T &pElement) {
+        emplace_back(pElement);
+    }
+
+    void push_back (T &&pElement) {
+        emplace_back(std::move(pElement));
+    }
+
+    // nothing moves on growth, so pArgs referring to own elements are fine
+    template <typename... Args>
+    T& emplace_back (Args&&... pArgs) {
+        reserve(_used_size + 1);
+        T *res = new (&(*this)[_used_size]) T(std::forward<Args>(pArgs)...);
+        ++_used_size;
+        return *res;
+    }
+
+    template <typename ValueT>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<ValueT>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueT*;
+        using reference = ValueT&;
+
+        Iterator (T* const *pSegments,
+                  const size_t pSegmentCount,
+                  const size_t pIndex)
+            : _segments (pSegments),
+              _segmentCount (pSegmentCount),
+              _index (pIndex) {
+            enterSegment();
+        }
+        Iterator& operator++ () {
+            ++_index;
+            if (++_current == _segmentEnd) {
+                enterSegment();
+            }
+            return *this;
+        }
+        Iterator operator++ (int) {
+            Iterator res = *this;
+            ++*this;
+            return res;
+        }
+        bool operator== (const Iterator &pOther) const {
+            return _index == pOther._index;
+        }
+        bool operator!= (const Iterator &pOther) const {
+            return _index != pOther._index;
+        }
+        reference operator* () const {
+            return *_current;
+        }
+        pointer operator-> () const {
+            return _current;
+        }
+    private:
+        void enterSegment () {
+            const size_t seg = Index::segmentOf(_index);
+            if (seg < _segmentCount) {
+                _current = _segments[seg] + Index::offsetIn(_index, seg);
+                _segmentEnd = _segments[seg] + Index::segmentSize(seg);
+            }
+        }
+
+        T* const *_segments;
+        size_t _segmentCount;
+        size_t _index;
+        T *_current = nullptr;
+        T *_segmentEnd = nullptr;
+    };
+
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
+    iterator begin () {
+        return iterator(_segments.data(), _segments.size(), 0);
+    }
+    iterator end () {
+        return iterator(nullptr, 0, _used_size);
+    }
+    const_iterator begin () const {
+        return const_iterator(_segments.data(), _segments.size(), 0);
+    }
+    const_iterator end () const {
+        return const_iterator(nullptr, 0, _used_size);
+    }
+
+    const AllocatorT& get_allocator () const {
+        return _allocator;
+    }
+
+private:
+    void destroy (const size_t pFrom, const size_t pTo) {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = pFrom; i < pTo; ++i) {
+                (*this)[i].~T();
+            }
+        }
+    }
+
+    void release () {
+        nullify();
+        for (size_t seg = 0; seg < _segments.size(); ++seg) {
+            _allocator.deallocate(_segments[seg],
+                                  Index::segmentSize(seg) * sizeof(T),
+                                  alignof(T));
+        }
+        _segments.nullify();
+    }
+
+    AllocatorT _allocator;
+    SimpleVector<T*> _segments;
+    size_t _used_size = 0;
+};
+
+} // namespace VcppBits
+
+#endif // VcppBits_SIMPLE_VECTOR_SEGMENTED_VECTOR_HPP_INCLUDED__
@@ -28,9 +28,113 @@
 
 #include "VcppBits/SimpleVector/SimpleVector.hpp"
 
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+
 
 namespace VcppBits {
 
-void (*SimpleVectorStaticData::_static_grow_callback) (void) = nullptr;
+std::atomic<void (*) (void)>
+SimpleVectorStaticData::_static_grow_callback { nullptr };
+
+namespace {
+
+std::atomic<size_t> global_grow_events { 0 };
+std::atomic<size_t> global_bytes_allocated { 0 };
+std::atomic<size_t> global_bytes_copied { 0 };
+
+// function-local statics, so vectors growing during static initialization
+// of other translation units find these constructed
+std::mutex& tagsMutex () {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::map<std::string, SimpleVectorGrowStats, std::less<>>& tagsStats () {
+    static std::map<std::string, SimpleVectorGrowStats, std::less<>> stats;
+    return stats;
+}
+
+} // namespace
+
+
+void SimpleVectorStaticData::recordGrow (const char *pTag,
+                                         const size_t pBytesAllocated,
+                                         const size_t pBytesCopied) {
+    global_grow_events.fetch_add(1, std::memory_order_relaxed);
+    global_bytes_allocated.fetch_add(pBytesAllocated,
+                                     std::memory_order_relaxed);
+    global_bytes_copied.fetch_add(pBytesCopied, std::memory_order_relaxed);
+
+    if (!pTag) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(tagsMutex());
+    auto &tags = tagsStats();
+    auto it = tags.find(std::string_view(pTag));
+    if (it == tags.end()) {
+        it = tags.emplace(pTag, SimpleVectorGrowStats()).first;
+    }
+    ++it->second.growEvents;
+    it->second.bytesAllocated += pBytesAllocated;
+    it->second.bytesCopied += pBytesCopied;
+}
+
+SimpleVectorGrowStats SimpleVectorStaticData::getGlobalGrowStats () {
+    SimpleVectorGrowStats res;
+    res.growEvents = global_grow_events.load(std::memory_order_relaxed);
+    res.bytesAllocated =
+        global_bytes_allocated.load(std::memory_order_relaxed);
+    res.bytesCopied = global_bytes_copied.load(std::memory_order_relaxed);
+    return res;
+}
+
+std::vector<std::pair<std::string, SimpleVectorGrowStats>>
+SimpleVectorStaticData::getTaggedGrowStats () {
+    std::vector<std::pair<std::string, SimpleVectorGrowStats>> res;
+    {
+        std::lock_guard<std::mutex> lock(tagsMutex());
+        res.assign(tagsStats().begin(), tagsStats().end());
+    }
+    std::stable_sort(res.begin(),
+                     res.end(),
+                     [] (const auto &pLeft, const auto &pRight) {
+                         return pLeft.second.growEvents
+                             > pRight.second.growEvents;
+                     });
+    return res;
+}
+
+void SimpleVectorStaticData::resetGrowStats () {
+    global_grow_events = 0;
+    global_bytes_allocated = 0;
+    global_bytes_copied = 0;
+
+    std::lock_guard<std::mutex> lock(tagsMutex());
+    tagsStats().clear();
+}
+
+void SimpleVectorStaticData::dumpGrowReport (std::ostream &pOut) {
+    const auto print_row = [&pOut] (const std::string_view pName,
+                                    const SimpleVectorGrowStats &pStats) {
+        pOut << std::left << std::setw(48) << pName << std::right
+             << std::setw(10) << pStats.growEvents
+             << std::setw(16) << pStats.bytesAllocated
+             << std::setw(16) << pStats.bytesCopied << '\n';
+    };
+
+    pOut << std::left << std::setw(48) << "SimpleVector growth" << std::right
+         << std::setw(10) << "grows"
+         << std::setw(16) << "allocated"
+         << std::setw(16) << "copied" << '\n';
+    for (const auto &tag : getTaggedGrowStats()) {
+        print_row(tag.first, tag.second);
+    }
+    print_row("(total)", getGlobalGrowStats());
+}
 
 } // namespace VcppBits
@@ -25,66 +25,142 @@
 #ifndef VcppBits_SIMPLE_VECTOR_HPP_INCLUDED__
 #define VcppBits_SIMPLE_VECTOR_HPP_INCLUDED__
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstring>
+#include <iosfwd>
+#include <iterator>
+#include <new>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "VcppBits/SimpleVector/Allocators.hpp"
 
 namespace VcppBits {
 
+// operator[] bounds checks: on by default in debug builds, define to 0 or 1
+// to override. at() is always checked
+#ifndef VcppBits_SIMPLE_VECTOR_CHECK_BOUNDS
+#ifdef NDEBUG
+#define VcppBits_SIMPLE_VECTOR_CHECK_BOUNDS 0
+#else
+#define VcppBits_SIMPLE_VECTOR_CHECK_BOUNDS 1
+#endif
+#endif
+
+// Tag for SimpleVector::set_tag(), e.g. "Foo.cpp:42"
+#define VcppBits_SIMPLE_VECTOR_STRINGIFY_(x) #x
+#define VcppBits_SIMPLE_VECTOR_STRINGIFY(x) VcppBits_SIMPLE_VECTOR_STRINGIFY_(x)
+#define VcppBits_SIMPLE_VECTOR_HERE \
+    (__FILE__ ":" VcppBits_SIMPLE_VECTOR_STRINGIFY(__LINE__))
+
+struct SimpleVectorGrowStats {
+    size_t growEvents = 0;
+    size_t bytesAllocated = 0;
+    // bytes moved to the new block by SimpleVector itself. Growth done by
+    // the allocator's reallocate() isn't counted, it often doesn't copy
+    size_t bytesCopied = 0;
+};
+
 class SimpleVectorStaticData {
 public:
-    static void (*_static_grow_callback) (void);
+    static std::atomic<void (*) (void)> _static_grow_callback;
+
+    // every grow() of every SimpleVector ends up here. Global counters are
+    // atomics, tagged vectors are also accounted per tag, under a mutex
+    static void recordGrow (const char *pTag,
+                            const size_t pBytesAllocated,
+                            const size_t pBytesCopied);
+
+    static SimpleVectorGrowStats getGlobalGrowStats ();
+    // sorted by grow events, most frequent first
+    static std::vector<std::pair<std::string, SimpleVectorGrowStats>>
+    getTaggedGrowStats ();
+    static void resetGrowStats ();
+
+    // table of tagged vectors, followed by global totals
+    static void dumpGrowReport (std::ostream &pOut);
 };
 
 
-template <typename T>
+// Storage is allocated uninitialized, elements are constructed in place.
+// Trivially copyable elements are relocated with memcpy on growth (or rather
+// realloc, see grow()), others are move-constructed into the new storage.
+//
+// Memory comes from AllocatorT, see Allocators.hpp. data() is aligned to
+// AlignmentV, e.g. 32/64 for aligned SIMD loads or to keep vectors written
+// by different threads off each other's cache lines
+template <typename T,
+          typename AllocatorT = HeapAllocator,
+          size_t AlignmentV = alignof(T)>
 class SimpleVector {
+    static_assert(AlignmentV >= alignof(T),
+                  "SimpleVector: alignment is less than alignof(T)");
+    static_assert((AlignmentV & (AlignmentV - 1)) == 0,
+                  "SimpleVector: alignment is not a power of two");
 public:
-    SimpleVector (const size_t sz = 0) {
-        if (sz)
-            _data = new T[sz];
+    using allocator_type = AllocatorT;
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    static constexpr size_t alignment = AlignmentV;
+
+    SimpleVector (const size_t sz = 0,
+                  const AllocatorT &pAllocator = AllocatorT())
+        : _allocator (pAllocator) {
+        if (sz) {
+            _data = allocate(sz);
+        }
         _allocated_size = sz;
     }
 
+    explicit SimpleVector (const AllocatorT &pAllocator)
+        : SimpleVector (0, pAllocator) {
+    }
+
     ~SimpleVector() {
-        if (!_isViewOnly) {
-            delete[] _data;
-        }
+        release();
     }
 
     SimpleVector (const SimpleVector&) = delete;
     SimpleVector operator= (const SimpleVector&) = delete;
     SimpleVector (SimpleVector &&pOther)
-        : _grow_callback (pOther._grow_callback),
-          _used_size (pOther._used_size),
-          _allocated_size (pOther._allocated_size),
-          _data (pOther._data),
-          _isViewOnly (pOther._isViewOnly) {
-        // TODO5: figure out proper way of doing this (and move assignment)
-        pOther._grow_callback = nullptr;
-        pOther._used_size = 0;
-        pOther._allocated_size = 0;
-        pOther._data = nullptr;
-        pOther._isViewOnly = false;
+        : _allocator (std::move(pOther._allocator)),
+          _grow_callback (pOther._grow_callback),
+          _tag (pOther._tag),
+          _grow_stats (pOther._grow_stats) {
+        takeFrom(pOther);
     }
     SimpleVector& operator= (SimpleVector && pOther) {
-        _grow_callback = (pOther._grow_callback);
-        _used_size = (pOther._used_size);
-        _allocated_size = (pOther._allocated_size);
-        _data = pOther._data;
-        _isViewOnly = pOther._isViewOnly;
+        if (this == &pOther) {
+            return *this;
+        }
+        release();
 
-        pOther._grow_callback = nullptr;
-        pOther._used_size = 0;
-        pOther._allocated_size = 0;
-        pOther._data = nullptr;
-        pOther._isViewOnly = false;
+        _allocator = std::move(pOther._allocator);
+        _grow_callback = (pOther._grow_callback);
+        _tag = pOther._tag;
+        _grow_stats = pOther._grow_stats;
+        takeFrom(pOther);
 
         return *this;
     }
 
+    // NOTE: first pUsedSize elements at pData are expected to be constructed
+    // already. resize()/nullify() construct and destroy elements as usual,
+    // but the view leaves whatever is left alive when it's destroyed
     void initializeByMemory (T* pData,
                              const size_t pAllocatedSize,
                              const size_t pUsedSize) {
+        release();
         _data = pData;
         _used_size = pUsedSize;
         _allocated_size = pAllocatedSize;
@@ -92,6 +168,7 @@ public:
     }
 
     void nullify () {
+        destroy(0, _used_size);
         _used_size = 0;
     }
 
@@ -99,8 +176,18 @@ public:
         return _used_size;
     }
 
+    bool empty () const {
+        return _used_size == 0;
+    }
+
+    // new elements are default-initialized, i.e. trivial types are left
+    // uninitialized, same as with new T[]
     void resize (const size_t pSize) {
         reserve(pSize);
+        for (size_t i = _used_size; i < pSize; ++i) {
+            new (_data + i) T;
+        }
+        destroy(pSize, _used_size);
         _used_size = pSize;
     }
 
@@ -110,35 +197,71 @@ public:
         }
     }
 
+    // checked only with VcppBits_SIMPLE_VECTOR_CHECK_BOUNDS, so that indexed
+    // loops compile to the same code as loops over a raw pointer
     T& operator[] (const size_t pNum) {
-        if (pNum >= _allocated_size) {
-            throw std::out_of_range("eh");
-        }
+#if VcppBits_SIMPLE_VECTOR_CHECK_BOUNDS
+        checkIndex(pNum);
+#endif
         return _data[pNum];
     }
 
     const T& operator[] (const size_t pNum) const {
-        if (pNum >= _allocated_size) {
-            throw std::out_of_range("ehh");
-        }
+#if VcppBits_SIMPLE_VECTOR_CHECK_BOUNDS
+        checkIndex(pNum);
+#endif
+        return _data[pNum];
+    }
+
+    // always checked
+    T& at (const size_t pNum) {
+        checkIndex(pNum);
+        return _data[pNum];
+    }
+
+    const T& at (const size_t pNum) const {
+        checkIndex(pNum);
         return _data[pNum];
     }
 
     void grow (const size_t pNewSize) {
         if (_isViewOnly) {
-            throw;
+            throw std::logic_error("SimpleVector: can't grow a view");
+        }
+        if (pNewSize < _used_size) {
+            throw std::length_error("SimpleVector: can't shrink by grow()");
         }
 
-        T* new_ptr = new T[pNewSize];
-        if (_data) {
-            std::memcpy(new_ptr, _data, _used_size * sizeof(T));
-            delete[] _data;
+        // HeapAllocator's realloc can often extend the block in place. For
+        // big blocks, which glibc keeps in their own mmap()ings, it uses
+        // mremap(), so even multi-GB buffers grow without copying or doubling
+        // the RSS
+        size_t bytes_copied = 0;
+        T* new_ptr = _data && !_isInline ? reallocate(pNewSize) : nullptr;
+        if (!new_ptr) {
+            new_ptr = allocate(pNewSize);
+            if (_data) {
+                relocate(_data, _used_size, new_ptr);
+                bytes_copied = _used_size * sizeof(T);
+                if (!_isInline) {
+                    deallocate(_data, _allocated_size);
+                }
+            }
         }
-        _allocated_size = pNewSize;
         _data = new_ptr;
-
-        if (SimpleVectorStaticData::_static_grow_callback) {
-            SimpleVectorStaticData::_static_grow_callback();
+        _allocated_size = pNewSize;
+        _isInline = false;
+
+        ++_grow_stats.growEvents;
+        _grow_stats.bytesAllocated += pNewSize * sizeof(T);
+        _grow_stats.bytesCopied += bytes_copied;
+        SimpleVectorStaticData::recordGrow(_tag,
+                                           pNewSize * sizeof(T),
+                                           bytes_copied);
+
+        if (auto callback = SimpleVectorStaticData::_static_grow_callback
+                .load(std::memory_order_relaxed)) {
+            callback();
         }
 
         if (_grow_callback) {
@@ -146,33 +269,51 @@ public:
         }
     }
 
-    class iterator {
-    public:
-        explicit iterator (T* pPtr)
-            : _current (pPtr) {
-        }
-        iterator operator++() {
-            ++_current;
-            return *this;
-        }
-        bool operator!=(const iterator& pOther) const {
-            return _current != pOther._current;
-        }
-        T& operator*() const {
-            return *_current;
-        }
-    private:
-        T* _current;
-    };
-
-    iterator begin () const { return iterator(_data); }
-    iterator end () const { return iterator(_data + _used_size); }
+    // plain pointers: the storage is contiguous, and that's how standard
+    // algorithms recognize it (memmove in std::copy and the like)
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    iterator begin () { return _data; }
+    iterator end () { return _data + _used_size; }
+    const_iterator begin () const { return _data; }
+    const_iterator end () const { return _data + _used_size; }
+    const_iterator cbegin () const { return begin(); }
+    const_iterator cend () const { return end(); }
+
+    reverse_iterator rbegin () { return reverse_iterator(end()); }
+    reverse_iterator rend () { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin () const {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend () const {
+        return const_reverse_iterator(begin());
+    }
+    const_reverse_iterator crbegin () const { return rbegin(); }
+    const_reverse_iterator crend () const { return rend(); }
 
     void push_back (const T& pElement) {
-        if ((_used_size) >= _allocated_size) {
+        emplace_back(pElement);
+    }
+
+    void push_back (T&& pElement) {
+        emplace_back(std::move(pElement));
+    }
+
+    template <typename... Args>
+    T& emplace_back (Args&&... pArgs) {
+        if (_used_size < _allocated_size) {
+            new (_data + _used_size) T(std::forward<Args>(pArgs)...);
+        }
+        else {
+            // pArgs may refer to our own elements, that are about to move
+            T element(std::forward<Args>(pArgs)...);
             grow(std::max<size_t>(8, _allocated_size * 2));
+            new (_data + _used_size) T(std::move(element));
         }
-        _data[_used_size++] = pElement;
+        return _data[_used_size++];
     }
 
     T* data () const {
@@ -191,16 +332,158 @@ public:
         SimpleVectorStaticData::_static_grow_callback = f_ptr;
     }
 
+    // pTag must outlive the vector, use string literals or
+    // VcppBits_SIMPLE_VECTOR_HERE. Growth of tagged vectors shows up in
+    // SimpleVectorStaticData::dumpGrowReport()
+    void set_tag (const char *pTag) {
+        _tag = pTag;
+    }
+
+    const char* get_tag () const {
+        return _tag;
+    }
+
+    const SimpleVectorGrowStats& get_grow_stats () const {
+        return _grow_stats;
+    }
+
+    const AllocatorT& get_allocator () const {
+        return _allocator;
+    }
+
+protected:
+    // Like initializeByMemory(), but the vector may still grow: elements are
+    // then moved out to the allocator's memory, and pData is left alone.
+    // SmallVector uses this for its inline buffer
+    void initializeByInlineMemory (T* pData, const size_t pAllocatedSize) {
+        release();
+        _data = pData;
+        _allocated_size = pAllocatedSize;
+        _isInline = true;
+    }
+
+    bool isInlineMemory () const {
+        return _isInline;
+    }
+
 private:
+    void checkIndex (const size_t pNum) const {
+        if (pNum >= _used_size) {
+            throw std::out_of_range("SimpleVector: index out of range");
+        }
+    }
+
+    static constexpr bool _canRealloc =
+        std::is_trivially_copyable<T>::value
+        && detail::HasReallocate<AllocatorT>::value;
+
+    T* allocate (const size_t pNum) {
+        return static_cast<T*>(
+            _allocator.allocate(pNum * sizeof(T), AlignmentV));
+    }
+
+    // nullptr if the allocator couldn't resize the block
+    T* reallocate (const size_t pNum) {
+        if constexpr (_canRealloc) {
+            return static_cast<T*>(
+                _allocator.reallocate(_data,
+                                      _allocated_size * sizeof(T),
+                                      pNum * sizeof(T),
+                                      AlignmentV));
+        }
+        else {
+            (void) pNum;
+            return nullptr;
+        }
+    }
+
+    void deallocate (T* pPtr, const size_t pNum) {
+        _allocator.deallocate(pPtr, pNum * sizeof(T), AlignmentV);
+    }
+
+    static void relocate (T* pFrom, const size_t pNum, T* pTo) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (pNum) {
+                std::memcpy(static_cast<void*>(pTo), pFrom, pNum * sizeof(T));
+            }
+        }
+        else {
+            for (size_t i = 0; i < pNum; ++i) {
+                new (pTo + i) T(std::move(pFrom[i]));
+                pFrom[i].~T();
+            }
+        }
+    }
+
+    void destroy (const size_t pFrom, const size_t pTo) {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = pFrom; i < pTo; ++i) {
+                _data[i].~T();
+            }
+        }
+    }
+
+    void release () {
+        if (!_isViewOnly && _data) {
+            destroy(0, _used_size);
+            if (!_isInline) {
+                deallocate(_data, _allocated_size);
+            }
+        }
+        _used_size = 0;
+        _allocated_size = 0;
+        _data = nullptr;
+        _isViewOnly = false;
+        _isInline = false;
+    }
+
+    // expects an empty *this with the allocator already in place
+    void takeFrom (SimpleVector &pOther) {
+        if (pOther._isInline) {
+            // inline memory belongs to pOther, only its elements can move
+            if (pOther._used_size) {
+                grow(pOther._used_size);
+                relocate(pOther._data, pOther._used_size, _data);
+                _used_size = pOther._used_size;
+                pOther._used_size = 0;
+            }
+            return;
+        }
+        _used_size = pOther._used_size;
+        _allocated_size = pOther._allocated_size;
+        _data = pOther._data;
+        _isViewOnly = pOther._isViewOnly;
+
+        pOther.forget();
+    }
+
+    // for moved-from vectors: drop everything without destroying
+    void forget () {
+        _grow_callback = nullptr;
+        _tag = nullptr;
+        _grow_stats = SimpleVectorGrowStats();
+        _used_size = 0;
+        _allocated_size = 0;
+        _data = nullptr;
+        _isViewOnly = false;
+    }
+
+    AllocatorT _allocator;
     void (*_grow_callback) (void) = nullptr;
+    const char *_tag = nullptr;
+    SimpleVectorGrowStats _grow_stats;
 
     size_t _used_size = 0;
-    size_t _allocated_size;
+    size_t _allocated_size = 0;
     T *_data = nullptr;
 
     bool _isViewOnly = false;
+    bool _isInline = false;
 };
 
+template <typename T, size_t AlignmentV = 64>
+using AlignedSimpleVector = SimpleVector<T, HeapAllocator, AlignmentV>;
+
 } // namespace VcppBits
 
 #endif // VcppBits_SIMPLE_VECTOR_HPP_INCLUDED__
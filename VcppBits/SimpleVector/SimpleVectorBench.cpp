@@ -0,0 +1,241 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+// SimpleVector vs std::vector on the usual vector workloads, for a trivially
+// copyable and a non-trivial element type.
+//
+// usage: simplevector-bench [ELEMENT_COUNT]
+//
+// Allocations are counted at the allocator on both sides: every allocate()
+// and reallocate() call of SimpleVector's allocator, and every allocate() of
+// std::vector's. Both vectors default-initialize on resize(), std::vector
+// through its allocator's construct(), so "resize" is the same work.
+
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "VcppBits/SimpleVector/SimpleVector.hpp"
+
+using VcppBits::HeapAllocator;
+using VcppBits::SimpleVector;
+
+namespace {
+
+// keeps the optimizer from throwing the benchmarked work away
+volatile size_t g_sink = 0;
+
+size_t g_allocations = 0;
+
+class CountingSimpleAllocator {
+public:
+    void* allocate (const size_t pBytes, const size_t pAlignment) {
+        ++g_allocations;
+        return HeapAllocator().allocate(pBytes, pAlignment);
+    }
+
+    void* reallocate (void *pPtr,
+                      const size_t pOldBytes,
+                      const size_t pNewBytes,
+                      const size_t pAlignment) {
+        ++g_allocations;
+        return HeapAllocator().reallocate(pPtr,
+                                          pOldBytes,
+                                          pNewBytes,
+                                          pAlignment);
+    }
+
+    void deallocate (void *pPtr, const size_t pBytes, const size_t pAlignment) {
+        HeapAllocator().deallocate(pPtr, pBytes, pAlignment);
+    }
+};
+
+template <typename T>
+using SimpleVec = SimpleVector<T, CountingSimpleAllocator>;
+
+// construct() without arguments default-initializes, like SimpleVector
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator () = default;
+    template <typename U>
+    CountingAllocator (const CountingAllocator<U>&) {
+    }
+
+    T* allocate (const size_t pNum) {
+        ++g_allocations;
+        return std::allocator<T>().allocate(pNum);
+    }
+
+    void deallocate (T *pPtr, const size_t pNum) {
+        std::allocator<T>().deallocate(pPtr, pNum);
+    }
+
+    template <typename U>
+    void construct (U *pPtr)
+        noexcept(std::is_nothrow_default_constructible<U>::value) {
+        ::new (static_cast<void*>(pPtr)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct (U *pPtr, Args&&... pArgs)
+        noexcept(std::is_nothrow_constructible<U, Args...>::value) {
+        ::new (static_cast<void*>(pPtr)) U(std::forward<Args>(pArgs)...);
+    }
+
+    template <typename U>
+    bool operator== (const CountingAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!= (const CountingAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using StdVector = std::vector<T, CountingAllocator<T>>;
+
+struct Trivial {
+    float x, y, z;
+    int id;
+};
+
+// long enough to not fit into the small string buffer
+struct NonTrivial {
+    std::string name = std::string(40, 'n');
+    int id = 0;
+};
+
+template <typename FuncT>
+void bench (const char *pName,
+            const char *pContainer,
+            const char *pType,
+            const size_t pOpsPerRun,
+            FuncT pFunc) {
+    using clock = std::chrono::steady_clock;
+    constexpr double min_seconds = 0.2;
+
+    pFunc(); // warmup
+
+    size_t runs = 0;
+    double seconds = 0.;
+    g_allocations = 0;
+    const auto start = clock::now();
+    do {
+        pFunc();
+        ++runs;
+        seconds = std::chrono::duration<double>(clock::now() - start).count();
+    } while (seconds < min_seconds);
+
+    const double ops = double(runs) * double(pOpsPerRun);
+    std::printf("%-12s %-14s %-11s %10.2f ns/op %10.1f allocs/run\n",
+                pName,
+                pContainer,
+                pType,
+                seconds * 1e9 / ops,
+                double(g_allocations) / double(runs));
+}
+
+template <typename VectorT>
+void fill (VectorT &pVector, const size_t pCount) {
+    using T = typename VectorT::value_type;
+    for (size_t i = 0; i < pCount; ++i) {
+        T element;
+        element.id = int(i);
+        pVector.push_back(std::move(element));
+    }
+}
+
+template <typename VectorT>
+void benchContainer (const char *pContainer,
+                     const char *pType,
+                     const size_t pCount) {
+    bench("push_back", pContainer, pType, pCount, [pCount] {
+        VectorT v;
+        fill(v, pCount);
+        g_sink = g_sink + v.size();
+    });
+
+    // default-initialized elements on both sides, see CountingAllocator
+    bench("resize-dflt", pContainer, pType, pCount, [pCount] {
+        VectorT v;
+        v.resize(pCount);
+        g_sink = g_sink + v.size();
+    });
+
+    VectorT v;
+    fill(v, pCount);
+
+    bench("iterate", pContainer, pType, pCount, [&v] {
+        size_t sum = 0;
+        for (const auto &element : v) {
+            sum += size_t(element.id);
+        }
+        g_sink = g_sink + sum;
+    });
+
+    bench("index", pContainer, pType, pCount, [&v] {
+        size_t sum = 0;
+        for (size_t i = 0; i < v.size(); ++i) {
+            sum += size_t(v[i].id);
+        }
+        g_sink = g_sink + sum;
+    });
+
+    bench("move", pContainer, pType, 2, [&v] {
+        VectorT moved(std::move(v));
+        v = std::move(moved);
+        g_sink = g_sink + v.size();
+    });
+}
+
+template <typename T>
+void benchType (const char *pType, const size_t pCount) {
+    benchContainer<SimpleVec<T>>("SimpleVector", pType, pCount);
+    benchContainer<StdVector<T>>("std::vector", pType, pCount);
+}
+
+} // namespace
+
+int main (int argc, char **argv) {
+    const size_t count = argc > 1
+        ? size_t(std::strtoull(argv[1], nullptr, 10))
+        : 100000;
+
+    std::printf("%zu elements\n", count);
+    benchType<Trivial>("Trivial", count);
+    benchType<NonTrivial>("NonTrivial", count);
+
+    return 0;
+}
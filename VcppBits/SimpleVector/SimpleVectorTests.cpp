@@ -0,0 +1,836 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#if defined(__unix__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <VcppBits/contrib/catch2/catch.hpp>
+
+#include "SimpleVector.hpp"
+#include "SmallVector.hpp"
+#include "HugePageAllocator.hpp"
+#include "MappedVector.hpp"
+#include "ConcurrentVector.hpp"
+#include "SegmentedVector.hpp"
+#include "SoAVector.hpp"
+#include "RingBuffer.hpp"
+
+using namespace VcppBits;
+
+namespace {
+
+struct Counted {
+    static int alive;
+    static int defaultConstructed;
+
+    Counted () : value (-1) { ++alive; ++defaultConstructed; }
+    explicit Counted (const int pValue) : value (pValue) { ++alive; }
+    Counted (const Counted &pOther) : value (pOther.value) { ++alive; }
+    Counted (Counted &&pOther) noexcept : value (pOther.value) {
+        pOther.value = -2;
+        ++alive;
+    }
+    Counted& operator= (const Counted&) = default;
+    ~Counted () { --alive; }
+
+    int value;
+};
+
+int Counted::alive = 0;
+int Counted::defaultConstructed = 0;
+
+struct ThrowsOnNegative {
+    static int alive;
+
+    explicit ThrowsOnNegative (const int pValue) : value (pValue) {
+        if (pValue < 0) {
+            throw std::invalid_argument("negative");
+        }
+        ++alive;
+    }
+    ~ThrowsOnNegative () { --alive; }
+
+    int value;
+};
+
+int ThrowsOnNegative::alive = 0;
+
+// move-only, and its move may throw
+struct ThrowingMove {
+    static int alive;
+    static int movesLeft;
+
+    explicit ThrowingMove (const int pValue) : value (pValue) { ++alive; }
+    ThrowingMove (ThrowingMove &&pOther) : value (pOther.value) {
+        if (movesLeft-- == 0) {
+            throw std::runtime_error("move");
+        }
+        ++alive;
+    }
+    ThrowingMove (const ThrowingMove&) = delete;
+    ~ThrowingMove () { --alive; }
+
+    int value;
+};
+
+int ThrowingMove::alive = 0;
+int ThrowingMove::movesLeft = 0;
+
+} // namespace (anonymous)
+
+
+TEST_CASE("SimpleVector doesn't construct spare capacity", "[SimpleVector]") {
+    Counted::alive = 0;
+    Counted::defaultConstructed = 0;
+    {
+        SimpleVector<Counted> v(100);
+        CHECK(v.capacity() == 100);
+        CHECK(Counted::alive == 0);
+
+        for (int i = 0; i < 1000; ++i) {
+            v.emplace_back(i);
+        }
+        CHECK(Counted::alive == 1000);
+        CHECK(Counted::defaultConstructed == 0);
+        CHECK(v[999].value == 999);
+
+        v.resize(10);
+        CHECK(Counted::alive == 10);
+        v.resize(12);
+        CHECK(Counted::alive == 12);
+        CHECK(Counted::defaultConstructed == 2);
+        CHECK(v[11].value == -1);
+
+        v.nullify();
+        CHECK(Counted::alive == 0);
+        v.push_back(Counted(5));
+    }
+    CHECK(Counted::alive == 0);
+}
+
+TEST_CASE("SimpleVector holds non-trivial types", "[SimpleVector]") {
+    SimpleVector<std::string> strings;
+    for (int i = 0; i < 100; ++i) {
+        strings.push_back(std::string(100, char('a' + i % 26)));
+    }
+    // growing while pushing own element
+    strings.push_back(strings[0]);
+    CHECK(strings.size() == 101);
+    CHECK(strings[100] == strings[0]);
+    CHECK(strings[99] == std::string(100, char('a' + 99 % 26)));
+
+    SimpleVector<std::unique_ptr<int>> ptrs;
+    for (int i = 0; i < 20; ++i) {
+        ptrs.emplace_back(new int(i));
+    }
+    CHECK(*ptrs[19] == 19);
+
+    SimpleVector<std::unique_ptr<int>> moved(std::move(ptrs));
+    CHECK(ptrs.size() == 0);
+    CHECK(ptrs.data() == nullptr);
+    CHECK(*moved[0] == 0);
+
+    ptrs = std::move(moved);
+    CHECK(ptrs.size() == 20);
+    ptrs = std::move(ptrs);
+    CHECK(ptrs.size() == 20);
+}
+
+TEST_CASE("SimpleVector as a view", "[SimpleVector]") {
+    int memory[4] = { 1, 2, 3, 4 };
+    SimpleVector<int> v;
+    v.initializeByMemory(memory, 4, 2);
+    CHECK(v.size() == 2);
+    v.resize(4);
+    CHECK(v[3] == 4);
+    CHECK_THROWS_AS(v.push_back(5), std::logic_error);
+}
+
+TEST_CASE("SimpleVector keeps trivial contents when growing", "[SimpleVector]") {
+    struct Pod { int a; double b; };
+    SimpleVector<Pod> v;
+    for (int i = 0; i < 100000; ++i) {
+        v.push_back(Pod{ i, i * 0.5 });
+    }
+    v.reserve(10000000);
+    CHECK(v.capacity() == 10000000);
+    REQUIRE(v.size() == 100000);
+    bool all_equal = true;
+    for (size_t i = 0; i < v.size(); ++i) {
+        all_equal = all_equal && v[i].a == int(i) && v[i].b == double(i) * 0.5;
+    }
+    CHECK(all_equal);
+}
+
+TEST_CASE("SimpleVector on a bump arena", "[SimpleVector][Allocators]") {
+    BumpArena arena(1024);
+    {
+        SimpleVector<int, ArenaAllocator> v(ArenaAllocator{ arena });
+        v.push_back(1);
+        const int *first_data = v.data();
+        // last allocation in the chunk gets extended in place
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(i);
+        }
+        CHECK(v.data() == first_data);
+        CHECK(v[100] == 99);
+
+        // doesn't fit into the first chunk anymore
+        v.reserve(1000);
+        CHECK(v[100] == 99);
+        CHECK(arena.chunkCount() == 2);
+
+        SimpleVector<std::string, ArenaAllocator> strings(0, v.get_allocator());
+        for (int i = 0; i < 50; ++i) {
+            strings.emplace_back(size_t(64), 'x');
+        }
+        CHECK(strings[49] == std::string(64, 'x'));
+    }
+
+    // chunks are reused after reset
+    const size_t chunks = arena.chunkCount();
+    arena.reset();
+    SimpleVector<int, ArenaAllocator> v(10, ArenaAllocator{ arena });
+    v.resize(1000);
+    CHECK(arena.chunkCount() == chunks);
+}
+
+TEST_CASE("SimpleVector on the size class pool", "[SimpleVector][Allocators]") {
+    const int *data = nullptr;
+    {
+        SimpleVector<int, PoolAllocator> v;
+        v.resize(100);
+        data = v.data();
+    }
+    SimpleVector<int, PoolAllocator> v;
+    v.reserve(100);
+    CHECK(v.data() == data);
+
+    // 100 and 120 ints are in the same 512 bytes class
+    v.reserve(120);
+    CHECK(v.data() == data);
+}
+
+namespace {
+std::atomic<bool> pool_gone_for_late_free { false };
+
+// destroyed after a thread's vectors that were created later
+struct PoolProbe {
+    ~PoolProbe () {
+        pool_gone_for_late_free = SizeClassPool::isThreadLocalDestroyed();
+    }
+};
+} // namespace
+
+TEST_CASE("PoolAllocator outlives the thread's pool", "[SimpleVector][Allocators]") {
+    std::thread([] {
+        thread_local PoolProbe probe;
+        // created before the pool, so destroyed after it
+        thread_local SimpleVector<int, PoolAllocator> late;
+        (void) probe;
+        late.resize(100);
+    }).join();
+    CHECK(pool_gone_for_late_free);
+}
+
+TEST_CASE("SmallVector stays inline until it spills", "[SimpleVector][SmallVector]") {
+    SmallVector<std::string, 4> v;
+    CHECK(v.capacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        v.push_back(std::string(32, char('a' + i)));
+    }
+    CHECK(v.isInline());
+
+    v.push_back(v[0]);
+    CHECK_FALSE(v.isInline());
+    CHECK(v.size() == 5);
+    CHECK(v[3] == std::string(32, 'd'));
+    CHECK(v[4] == std::string(32, 'a'));
+}
+
+TEST_CASE("SmallVector moves", "[SimpleVector][SmallVector]") {
+    SmallVector<std::unique_ptr<int>, 2> small;
+    small.push_back(std::make_unique<int>(1));
+
+    SmallVector<std::unique_ptr<int>, 2> moved(std::move(small));
+    REQUIRE(moved.size() == 1);
+    CHECK(*moved[0] == 1);
+    CHECK(moved.isInline());
+    CHECK(small.size() == 0);
+
+    // small is still usable and inline
+    small.push_back(std::make_unique<int>(2));
+    small.push_back(std::make_unique<int>(3));
+    small.push_back(std::make_unique<int>(4));
+    CHECK_FALSE(small.isInline());
+    const auto *heap_data = small.data();
+
+    moved = std::move(small);
+    CHECK(moved.data() == heap_data);
+    CHECK(*moved[2] == 4);
+    CHECK(small.isInline());
+    CHECK(small.capacity() == 2);
+
+    // moving into a plain SimpleVector can't take the inline buffer
+    small.push_back(std::make_unique<int>(5));
+    SimpleVector<std::unique_ptr<int>> plain(std::move(small));
+    REQUIRE(plain.size() == 1);
+    CHECK(*plain[0] == 5);
+    CHECK(small.size() == 0);
+}
+
+TEST_CASE("SimpleVector growth stats", "[SimpleVector]") {
+    const auto global_before = SimpleVectorStaticData::getGlobalGrowStats();
+
+    SimpleVector<int> v;
+    v.set_tag(VcppBits_SIMPLE_VECTOR_HERE);
+    for (int i = 0; i < 20; ++i) {
+        v.push_back(i);
+    }
+    // 8, 16, 32
+    CHECK(v.get_grow_stats().growEvents == 3);
+    CHECK(v.get_grow_stats().bytesAllocated == (8 + 16 + 32) * sizeof(int));
+
+    const auto global = SimpleVectorStaticData::getGlobalGrowStats();
+    CHECK(global.growEvents - global_before.growEvents >= 3);
+
+    const auto tags = SimpleVectorStaticData::getTaggedGrowStats();
+    const auto it = std::find_if(tags.begin(),
+                                 tags.end(),
+                                 [&v] (const auto &pTag) {
+                                     return pTag.first == v.get_tag();
+                                 });
+    REQUIRE(it != tags.end());
+    CHECK(it->second.growEvents >= 3);
+    CHECK(std::string(v.get_tag()).find("SimpleVectorTests.cpp:")
+          != std::string::npos);
+
+    std::ostringstream report;
+    SimpleVectorStaticData::dumpGrowReport(report);
+    CHECK(report.str().find(v.get_tag()) != std::string::npos);
+}
+
+TEST_CASE("SimpleVector with over-aligned storage", "[SimpleVector][Allocators]") {
+    AlignedSimpleVector<float> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(float(i));
+        REQUIRE(reinterpret_cast<std::uintptr_t>(v.data()) % 64 == 0);
+    }
+    CHECK(v[99] == 99.f);
+
+    SimpleVector<char, PoolAllocator, 4096> page;
+    page.resize(10);
+    CHECK(reinterpret_cast<std::uintptr_t>(page.data()) % 4096 == 0);
+
+    BumpArena arena;
+    SimpleVector<int, ArenaAllocator, 32> in_arena(0, ArenaAllocator{ arena });
+    SimpleVector<char, ArenaAllocator> misalign(3, ArenaAllocator{ arena });
+    in_arena.resize(50);
+    CHECK(reinterpret_cast<std::uintptr_t>(in_arena.data()) % 32 == 0);
+}
+
+TEST_CASE("SimpleVector on huge pages", "[SimpleVector][Allocators]") {
+    SimpleVector<int, HugePageAllocator> v(0, HugePageAllocator(64 * 1024));
+    v.resize(1000);
+    CHECK_FALSE(v.get_allocator().isMapped(v.capacity() * sizeof(int),
+                                           alignof(int)));
+    for (int i = 0; i < 1000; ++i) {
+        v[size_t(i)] = i;
+    }
+
+    // crosses the threshold, then grows in the mapping
+    v.resize(1024 * 1024);
+    v.resize(3 * 1024 * 1024);
+    CHECK(v[999] == 999);
+    v[v.size() - 1] = 42;
+    CHECK(v[v.size() - 1] == 42);
+#if defined(__linux__)
+    CHECK(v.get_allocator().isMapped(v.capacity() * sizeof(int),
+                                     alignof(int)));
+#endif
+}
+
+TEST_CASE("Huge page SimpleVector keeps alignment above page size", "[SimpleVector][Allocators]") {
+    SimpleVector<int, HugePageAllocator, 8192>
+        v(0, HugePageAllocator(64 * 1024));
+    bool aligned = true;
+    for (size_t size = 1024; size <= 4 * 1024 * 1024; size *= 2) {
+        v.resize(size);
+        v[size - 1] = int(size);
+        aligned = aligned
+            && reinterpret_cast<std::uintptr_t>(v.data()) % 8192 == 0;
+    }
+    CHECK(aligned);
+    CHECK(v[1023] == 1024);
+
+#if defined(__linux__)
+    // mremap() only keeps page alignment, so the caller has to relocate
+    HugePageAllocator allocator(64 * 1024);
+    const size_t bytes = 1024 * 1024;
+    void *block = allocator.allocate(bytes, 8192);
+    CHECK(allocator.reallocate(block, bytes, 4 * bytes, 8192) == nullptr);
+    allocator.deallocate(block, bytes, 8192);
+#endif
+}
+
+TEST_CASE("MappedVector persists elements", "[SimpleVector][MappedVector]") {
+    const auto filename = "test_MappedVector_0.bin";
+    struct Point {
+        float x, y;
+    };
+    {
+        MappedVector<Point> v(filename, MappedFile::OpenMode::CREATE_NEW);
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(Point{ float(i), float(-i) });
+        }
+        v.push_back(v[0]);
+        v.flush();
+    }
+    {
+        MappedVector<Point> v(filename, MappedFile::OpenMode::OPEN_EXISTING);
+        REQUIRE(v.size() == 1001);
+        CHECK(v[999].x == 999.f);
+        CHECK(v[999].y == -999.f);
+        CHECK(v[1000].x == 0.f);
+        v.resize(10);
+    }
+    {
+        MappedVector<Point> v(filename);
+        CHECK(v.size() == 10);
+        CHECK(v.capacity() >= 1001);
+    }
+    CHECK_THROWS_AS(MappedVector<int>(filename), std::runtime_error);
+    std::remove(filename);
+    CHECK_THROWS_AS(MappedVector<double>(filename,
+                                         MappedFile::OpenMode::OPEN_EXISTING),
+                    std::system_error);
+}
+
+TEST_CASE("ConcurrentVector takes pushes from many threads", "[SimpleVector][ConcurrentVector]") {
+    ConcurrentVector<std::pair<int, int>> v;
+    const int per_thread = 20000;
+    std::vector<std::thread> threads;
+    std::vector<const std::pair<int, int>*> first_elements(4, nullptr);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&v, &first_elements, t] {
+            first_elements[size_t(t)] = &v.emplace_back(t, 0);
+            for (int i = 1; i < per_thread; ++i) {
+                v.push_back({ t, i });
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(v.size() == 4 * per_thread);
+    // each thread's elements are in its push order
+    std::vector<int> next(4, 0);
+    bool in_order = true;
+    for (const auto &element : v) {
+        in_order = in_order && element.second == next[size_t(element.first)]++;
+    }
+    CHECK(in_order);
+    // nothing was moved while growing
+    for (int t = 0; t < 4; ++t) {
+        CHECK(first_elements[size_t(t)]->first == t);
+        CHECK(first_elements[size_t(t)]->second == 0);
+    }
+}
+
+TEST_CASE("ConcurrentVector survives throwing constructors", "[SimpleVector][ConcurrentVector]") {
+    ThrowsOnNegative::alive = 0;
+    {
+        ConcurrentVector<ThrowsOnNegative> v;
+        int thrown = 0;
+        for (int i = 0; i < 20; ++i) {
+            try {
+                v.emplace_back(i % 7 == 3 ? -1 : i);
+            }
+            catch (const std::invalid_argument&) {
+                ++thrown;
+            }
+        }
+        REQUIRE(thrown == 3);
+        CHECK(v.size() == 20);
+        CHECK(ThrowsOnNegative::alive == 17);
+        CHECK_FALSE(v.is_constructed(3));
+        CHECK(v.is_constructed(4));
+
+        int visited = 0;
+        bool skipped_empty = true;
+        for (const auto &element : v) {
+            skipped_empty = skipped_empty && element.value >= 0;
+            ++visited;
+        }
+        CHECK(visited == 17);
+        CHECK(skipped_empty);
+
+        v.clear();
+        CHECK(ThrowsOnNegative::alive == 0);
+        v.emplace_back(5);
+        CHECK(v.is_constructed(0));
+        CHECK_FALSE(v.is_constructed(3));
+    }
+    CHECK(ThrowsOnNegative::alive == 0);
+}
+
+TEST_CASE("SegmentedVector keeps element addresses", "[SimpleVector][SegmentedVector]") {
+    SegmentedVector<std::string> v;
+    v.push_back("first");
+    const std::string *first = &v[0];
+    for (int i = 1; i < 1000; ++i) {
+        v.push_back(v[size_t(i - 1)]);
+    }
+    CHECK(&v[0] == first);
+    CHECK(v.size() == 1000);
+    CHECK(v.capacity() >= 1000);
+
+    size_t count = 0;
+    for (const auto &element : v) {
+        count += element == "first";
+    }
+    CHECK(count == 1000);
+
+    v.resize(8);
+    CHECK(v.size() == 8);
+
+    SegmentedVector<std::string> moved(std::move(v));
+    CHECK(&moved[0] == first);
+    CHECK(v.size() == 0);
+
+    // iterating segment boundary exactly at the end
+    SegmentedVector<int> ints;
+    for (int i = 0; i < 24; ++i) {
+        ints.push_back(i);
+    }
+    int sum = 0;
+    for (const int value : ints) {
+        sum += value;
+    }
+    CHECK(sum == 23 * 24 / 2);
+}
+
+TEST_CASE("SoAVector keeps fields in separate arrays", "[SimpleVector][SoAVector]") {
+    SoAVector<float, float, std::uint8_t> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back({ float(i), float(2 * i), std::uint8_t(i) });
+    }
+    v.emplace_back(1.f, 2.f, std::uint8_t(3));
+    REQUIRE(v.size() == 101);
+
+    auto xs = v.field<0>();
+    auto flags = v.field<2>();
+    CHECK(xs.size() == 101);
+    CHECK(reinterpret_cast<std::uintptr_t>(xs.data()) % 64 == 0);
+    CHECK(reinterpret_cast<std::uintptr_t>(flags.data()) % 64 == 0);
+    CHECK(flags[99] == 99);
+
+    float sum = 0;
+    for (const float x : xs) {
+        sum += x;
+    }
+    CHECK(sum == Approx(99 * 100 / 2 + 1));
+
+    std::get<1>(v[5]) = -1.f;
+    CHECK(v.get<1>(5) == -1.f);
+    CHECK(std::get<0>(std::as_const(v)[100]) == 1.f);
+
+    SoAVector<float, float, std::uint8_t> moved(std::move(v));
+    CHECK(moved.get<2>(100) == 3);
+    CHECK(v.size() == 0);
+}
+
+namespace {
+int soa_grows = 0;
+int soa_static_grows = 0;
+} // namespace
+
+TEST_CASE("SoAVector growth is reported", "[SimpleVector][SoAVector]") {
+    soa_grows = 0;
+    soa_static_grows = 0;
+    SimpleVector<int>::set_static_grow_callback([] { ++soa_static_grows; });
+
+    SoAVector<float, int> v;
+    v.set_grow_callback([] { ++soa_grows; });
+    v.set_tag("SoAVector growth test");
+    for (int i = 0; i < 9; ++i) {
+        v.emplace_back(float(i), i);
+    }
+    SimpleVector<int>::set_static_grow_callback(nullptr);
+
+    CHECK(soa_grows == 2);
+    CHECK(soa_static_grows == 2);
+    const auto tags = SimpleVectorStaticData::getTaggedGrowStats();
+    const auto it = std::find_if(tags.begin(),
+                                 tags.end(),
+                                 [&v] (const auto &pTag) {
+                                     return pTag.first == v.get_tag();
+                                 });
+    REQUIRE(it != tags.end());
+    CHECK(it->second.growEvents == 2);
+}
+
+TEST_CASE("SimpleVector works with standard algorithms", "[SimpleVector]") {
+    SimpleVector<int> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back((i * 37) % 100);
+    }
+    std::sort(v.begin(), v.end());
+    CHECK(std::is_sorted(v.cbegin(), v.cend()));
+    CHECK(std::lower_bound(v.begin(), v.end(), 42) - v.begin() == 42);
+    CHECK(*v.rbegin() == 99);
+    CHECK(std::distance(v.crbegin(), v.crend()) == 100);
+
+    const SimpleVector<int> &const_v = v;
+    static_assert(std::is_same<decltype(const_v.begin()),
+                               SimpleVector<int>::const_iterator>::value,
+                  "const begin() gives const_iterator");
+    static_assert(std::is_same<std::iterator_traits<SimpleVector<int>::iterator>
+                                   ::iterator_category,
+                               std::random_access_iterator_tag>::value,
+                  "iterator is random access");
+    CHECK(std::accumulate(const_v.begin(), const_v.end(), 0) == 99 * 100 / 2);
+}
+
+TEST_CASE("SimpleVector bounds checks", "[SimpleVector]") {
+    SimpleVector<int> v(16);
+    v.resize(4);
+    CHECK(v.at(3) == v[3]);
+    // in capacity, but not in size
+    CHECK_THROWS_AS(v.at(4), std::out_of_range);
+#if VcppBits_SIMPLE_VECTOR_CHECK_BOUNDS
+    CHECK_THROWS_AS(v[4], std::out_of_range);
+#endif
+}
+
+TEST_CASE("RingBuffer works at both ends", "[SimpleVector][RingBuffer]") {
+    RingBuffer<std::string> ring(3);
+    CHECK(ring.capacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        ring.push_back(std::to_string(i));
+    }
+    ring.pop_front();
+    ring.pop_front();
+    ring.push_back("4");
+    ring.push_front("1");
+    // 1 2 3 4, wrapped around
+    REQUIRE(ring.size() == 4);
+    CHECK(ring.front() == "1");
+    CHECK(ring.back() == "4");
+    CHECK(ring.firstSpan().second + ring.secondSpan().second == 4);
+    CHECK(ring.firstSpan().first[0] == "1");
+
+    // grows, unwrapping the contents
+    ring.push_back(ring.front());
+    CHECK(ring.capacity() == 8);
+    CHECK(ring.firstSpan().second == 5);
+    CHECK(ring[4] == "1");
+    CHECK(ring[3] == "4");
+}
+
+TEST_CASE("RingBuffer overwrites when full", "[SimpleVector][RingBuffer]") {
+    int history[4] = {};
+    RingBuffer<int> ring;
+    ring.initializeByMemory(history, 4);
+    for (int frame = 0; frame < 10; ++frame) {
+        ring.push_back(frame);
+    }
+    CHECK(ring.size() == 4);
+    CHECK(ring.front() == 6);
+    CHECK(ring.back() == 9);
+
+    int copy[4];
+    const auto first = ring.firstSpan();
+    const auto second = ring.secondSpan();
+    std::memcpy(copy, first.first, first.second * sizeof(int));
+    std::memcpy(copy + first.second, second.first, second.second * sizeof(int));
+    CHECK(copy[0] == 6);
+    CHECK(copy[3] == 9);
+    CHECK(history[0] == 8);
+
+    CHECK_THROWS_AS(ring.reserve(8), std::logic_error);
+    ring.reserve(4);
+    CHECK(ring.capacity() == 4);
+    CHECK(ring.front() == 6);
+}
+
+TEST_CASE("RingBuffer inserts its own elements", "[SimpleVector][RingBuffer]") {
+    RingBuffer<std::string> ring(4, RingBuffer<std::string>::Overflow::OVERWRITE);
+    for (int i = 0; i < 4; ++i) {
+        ring.push_back(std::string(32, char('a' + i)));
+    }
+    // the element pushed is the one evicted
+    ring.push_back(ring.front());
+    CHECK(ring.back() == std::string(32, 'a'));
+    CHECK(ring.front() == std::string(32, 'b'));
+    ring.push_front(ring.back());
+    CHECK(ring.front() == std::string(32, 'a'));
+    CHECK(ring.size() == 4);
+}
+
+TEST_CASE("RingBuffer survives a throwing move while growing", "[SimpleVector][RingBuffer]") {
+    ThrowingMove::alive = 0;
+    {
+        RingBuffer<ThrowingMove> ring(8);
+        for (int i = 0; i < 8; ++i) {
+            ring.emplace_back(i);
+        }
+        ThrowingMove::movesLeft = 3;
+        CHECK_THROWS_AS(ring.emplace_back(8), std::runtime_error);
+        CHECK(ThrowingMove::alive == 8);
+        REQUIRE(ring.size() == 8);
+        CHECK(ring.capacity() == 8);
+        bool intact = true;
+        for (int i = 0; i < 8; ++i) {
+            intact = intact && ring[size_t(i)].value == i;
+        }
+        CHECK(intact);
+
+        ThrowingMove::movesLeft = 100;
+        ring.emplace_back(8);
+        CHECK(ring.size() == 9);
+        CHECK(ring.back().value == 8);
+        CHECK(ThrowingMove::alive == 9);
+    }
+    CHECK(ThrowingMove::alive == 0);
+}
+
+TEST_CASE("RingBuffer growth is accounted", "[SimpleVector][RingBuffer]") {
+    const auto before = SimpleVectorStaticData::getGlobalGrowStats();
+    RingBuffer<int> ring;
+    for (int i = 0; i < 20; ++i) {
+        ring.push_back(i);
+    }
+    // 8, 16, 32
+    CHECK(SimpleVectorStaticData::getGlobalGrowStats().growEvents
+          - before.growEvents >= 3);
+    CHECK_THROWS_AS(ring.reserve(std::numeric_limits<size_t>::max()),
+                    std::length_error);
+    CHECK(ring[19] == 19);
+}
+
+#if defined(__unix__)
+TEST_CASE("MappedVector shared between processes", "[SimpleVector][MappedVector]") {
+    const std::string name = "/VcppBits_test_" + std::to_string(getpid());
+    auto writer = MappedVector<int>::openShared(name,
+                                                MappedFile::OpenMode::CREATE_NEW,
+                                                4);
+    auto reader = MappedVector<int>::openShared(name,
+                                                MappedFile::OpenMode::OPEN_EXISTING);
+    CHECK(reader.size() == 0);
+
+    writer.push_back(1);
+    reader.refresh();
+    REQUIRE(reader.size() == 1);
+    CHECK(reader[0] == 1);
+
+    // writer grows the segment in another process
+    const pid_t child = fork();
+    if (child == 0) {
+        auto child_writer =
+            MappedVector<int>::openShared(name,
+                                          MappedFile::OpenMode::OPEN_EXISTING);
+        for (int i = 2; i <= 1000; ++i) {
+            child_writer.push_back(i);
+        }
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    REQUIRE(WIFEXITED(status));
+
+    reader.refresh();
+    REQUIRE(reader.size() == 1000);
+    CHECK(reader[999] == 1000);
+    CHECK(reader.capacity() >= 1000);
+}
+
+TEST_CASE("MappedVector doesn't take over a live shared object", "[SimpleVector][MappedVector]") {
+    const std::string name = "/VcppBits_test_excl_" + std::to_string(getpid());
+    auto writer = MappedVector<int>::openShared(name,
+                                                MappedFile::OpenMode::CREATE_NEW,
+                                                4);
+    writer.push_back(7);
+
+    CHECK_THROWS_AS(MappedVector<int>::openShared(name,
+                                                  MappedFile::OpenMode::CREATE_NEW,
+                                                  4),
+                    std::system_error);
+
+    auto reader = MappedVector<int>::openShared(name,
+                                                MappedFile::OpenMode::OPEN_EXISTING);
+    REQUIRE(reader.size() == 1);
+    CHECK(reader[0] == 7);
+}
+#endif
+
+TEST_CASE("SizeClassPool caps and counts recycled blocks", "[SimpleVector][Allocators]") {
+    SizeClassPool::Limits limits;
+    limits.maxBlocksPerClass = 2;
+    SizeClassPool pool(limits);
+
+    void *blocks[3];
+    for (auto &block : blocks) {
+        block = pool.allocate(100, alignof(int));
+    }
+    for (auto *block : blocks) {
+        pool.deallocate(block, 100, alignof(int));
+    }
+    CHECK(pool.getStats().misses == 3);
+    CHECK(pool.getStats().recycled == 2);
+    CHECK(pool.getStats().released == 1);
+    CHECK(pool.getStats().cachedBytes == 2 * SizeClassPool::classSize(
+                                                 SizeClassPool::sizeClass(100)));
+
+    void *again = pool.allocate(120, alignof(int));
+    CHECK(pool.getStats().hits == 1);
+    CHECK(pool.getStats().hitRate() == Approx(0.25));
+    pool.deallocate(again, 120, alignof(int));
+
+    pool.trim();
+    CHECK(pool.getStats().cachedBlocks == 0);
+    CHECK(pool.getStats().cachedBytes == 0);
+}
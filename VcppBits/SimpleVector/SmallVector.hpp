@@ -0,0 +1,107 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_SMALL_VECTOR_HPP_INCLUDED__
+#define VcppBits_SMALL_VECTOR_HPP_INCLUDED__
+
+#include <cstddef>
+
+#include "VcppBits/SimpleVector/SimpleVector.hpp"
+
+namespace VcppBits {
+
+namespace detail {
+
+template <typename T, size_t N>
+struct InlineStorage {
+    T* inlineData () {
+        return reinterpret_cast<T*>(_inlineStorage);
+    }
+
+    alignas(T) unsigned char _inlineStorage[N * sizeof(T)];
+};
+
+} // namespace detail
+
+
+// SimpleVector that keeps first N elements in place and goes to the
+// allocator only when they don't fit. Storage is a base listed first, so it
+// outlives elements that SimpleVector's destructor destroys
+template <typename T, size_t N, typename AllocatorT = HeapAllocator>
+class SmallVector : private detail::InlineStorage<T, N>,
+                    public SimpleVector<T, AllocatorT> {
+    static_assert(N > 0, "SmallVector: use SimpleVector for N == 0");
+
+    using Storage = detail::InlineStorage<T, N>;
+    using Base = SimpleVector<T, AllocatorT>;
+public:
+    explicit SmallVector (const AllocatorT &pAllocator = AllocatorT())
+        : Base (pAllocator) {
+        this->initializeByInlineMemory(Storage::inlineData(), N);
+    }
+
+    SmallVector (SmallVector &&pOther)
+        : Base (pOther.get_allocator()) {
+        this->initializeByInlineMemory(Storage::inlineData(), N);
+        takeFrom(pOther);
+    }
+
+    SmallVector& operator= (SmallVector &&pOther) {
+        if (this != &pOther) {
+            this->nullify();
+            takeFrom(pOther);
+        }
+        return *this;
+    }
+
+    // false once elements spilled to the allocator
+    bool isInline () const {
+        return this->isInlineMemory();
+    }
+
+    static constexpr size_t inlineCapacity () {
+        return N;
+    }
+
+private:
+    // expects an empty *this
+    void takeFrom (SmallVector &pOther) {
+        if (pOther.isInline()) {
+            this->reserve(pOther.size());
+            for (auto &element : pOther) {
+                this->emplace_back(std::move(element));
+            }
+            pOther.nullify();
+        }
+        else {
+            Base::operator=(static_cast<Base&&>(pOther));
+            pOther.initializeByInlineMemory(pOther.inlineData(), N);
+        }
+    }
+};
+
+} // namespace VcppBits
+
+#endif // VcppBits_SMALL_VECTOR_HPP_INCLUDED__
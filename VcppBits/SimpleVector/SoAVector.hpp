@@ -0,0 +1,310 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_SIMPLE_VECTOR_SOA_VECTOR_HPP_INCLUDED__
+#define VcppBits_SIMPLE_VECTOR_SOA_VECTOR_HPP_INCLUDED__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "VcppBits/SimpleVector/Allocators.hpp"
+#include "VcppBits/SimpleVector/SimpleVector.hpp"
+
+namespace VcppBits {
+
+// pointer and size of one SoAVector field
+template <typename T>
+class FieldSpan {
+public:
+    FieldSpan (T *pData, const size_t pSize)
+        : _data (pData),
+          _size (pSize) {
+    }
+
+    T* data () const { return _data; }
+    size_t size () const { return _size; }
+    T* begin () const { return _data; }
+    T* end () const { return _data + _size; }
+
+    T& operator[] (const size_t pNum) const {
+        return _data[pNum];
+    }
+
+private:
+    T *_data;
+    size_t _size;
+};
+
+
+// Struct of arrays: element i is (field<0>()[i], field<1>()[i], ...). Each
+// field is a contiguous array aligned to a cache line, so loops touching one
+// or two fields only load those. All arrays share one allocation and grow
+// together. Fields must be trivially copyable; growth is SimpleVector-like
+// and is accounted in SimpleVectorStaticData.
+template <typename... Fields>
+class SoAVector {
+    static_assert(sizeof...(Fields) > 0, "SoAVector: no fields");
+    static_assert(std::conjunction<std::is_trivially_copyable<Fields>...>::value,
+                  "SoAVector: fields must be trivially copyable");
+
+    static constexpr size_t FIELD_ALIGNMENT =
+        std::max({ size_t(64), alignof(Fields)... });
+    using Indices = std::index_sequence_for<Fields...>;
+public:
+    using value_type = std::tuple<Fields...>;
+
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, value_type>;
+
+    explicit SoAVector (const size_t pCapacity = 0) {
+        if (pCapacity) {
+            grow(pCapacity);
+        }
+    }
+
+    ~SoAVector () {
+        release();
+    }
+
+    SoAVector (const SoAVector&) = delete;
+    SoAVector& operator= (const SoAVector&) = delete;
+
+    SoAVector (SoAVector &&pOther)
+        : _fields (std::exchange(pOther._fields, std::tuple<Fields*...>())),
+          _block (std::exchange(pOther._block, nullptr)),
+          _blockSize (std::exchange(pOther._blockSize, 0)),
+          _used_size (std::exchange(pOther._used_size, 0)),
+          _allocated_size (std::exchange(pOther._allocated_size, 0)),
+          _grow_callback (std::exchange(pOther._grow_callback, nullptr)),
+          _tag (std::exchange(pOther._tag, nullptr)) {
+    }
+
+    SoAVector& operator= (SoAVector &&pOther) {
+        if (this != &pOther) {
+            release();
+            _fields = std::exchange(pOther._fields, std::tuple<Fields*...>());
+            _block = std::exchange(pOther._block, nullptr);
+            _blockSize = std::exchange(pOther._blockSize, 0);
+            _used_size = std::exchange(pOther._used_size, 0);
+            _allocated_size = std::exchange(pOther._allocated_size, 0);
+            _grow_callback = std::exchange(pOther._grow_callback, nullptr);
+            _tag = std::exchange(pOther._tag, nullptr);
+        }
+        return *this;
+    }
+
+    size_t size () const {
+        return _used_size;
+    }
+
+    size_t capacity () const {
+        return _allocated_size;
+    }
+
+    void reserve (const size_t pSize) {
+        if (pSize > _allocated_size) {
+            grow(pSize);
+        }
+    }
+
+    // new elements are left uninitialized, as with SimpleVector<int>
+    void resize (const size_t pSize) {
+        reserve(pSize);
+        _used_size = pSize;
+    }
+
+    void nullify () {
+        _used_size = 0;
+    }
+
+    void set_grow_callback (void (*f_ptr)(void)) {
+        _grow_callback = f_ptr;
+    }
+
+    // same contract as SimpleVector::set_tag()
+    void set_tag (const char *pTag) {
+        _tag = pTag;
+    }
+
+    const char* get_tag () const {
+        return _tag;
+    }
+
+    void push_back (const value_type &pElement) {
+        std::apply([this] (const Fields&... pFields) {
+                       emplace_back(pFields...);
+                   },
+                   pElement);
+    }
+
+    void emplace_back (const Fields&... pFields) {
+        if (_used_size == _allocated_size) {
+            // arguments may point into our arrays
+            value_type copy(pFields...);
+            grow(std::max<size_t>(8, _allocated_size * 2));
+            set(_used_size++, copy);
+        }
+        else {
+            set(_used_size++, std::tie(pFields...));
+        }
+    }
+
+    template <size_t I>
+    FieldSpan<FieldType<I>> field () {
+        return FieldSpan<FieldType<I>>(std::get<I>(_fields), _used_size);
+    }
+
+    template <size_t I>
+    FieldSpan<const FieldType<I>> field () const {
+        return FieldSpan<const FieldType<I>>(std::get<I>(_fields),
+                                             _used_size);
+    }
+
+    template <size_t I>
+    FieldType<I>& get (const size_t pNum) {
+        return std::get<I>(_fields)[pNum];
+    }
+
+    template <size_t I>
+    const FieldType<I>& get (const size_t pNum) const {
+        return std::get<I>(_fields)[pNum];
+    }
+
+    // tuple of references to all fields of element pNum
+    std::tuple<Fields&...> operator[] (const size_t pNum) {
+        return refs(pNum, Indices());
+    }
+
+    value_type operator[] (const size_t pNum) const {
+        return values(pNum, Indices());
+    }
+
+    template <typename TupleT>
+    void set (const size_t pNum, const TupleT &pElement) {
+        refs(pNum, Indices()) = pElement;
+    }
+
+    void grow (const size_t pNewSize) {
+        if (pNewSize < _used_size) {
+            throw std::length_error("SoAVector: can't shrink by grow()");
+        }
+        const size_t block_size = blockSize(pNewSize);
+        char *block =
+            static_cast<char*>(HeapAllocator().allocate(block_size,
+                                                        FIELD_ALIGNMENT));
+        std::tuple<Fields*...> fields;
+        assignFields(fields, block, pNewSize, Indices());
+        copyFields(fields, Indices());
+
+        release();
+        _fields = fields;
+        _block = block;
+        _blockSize = block_size;
+        _allocated_size = pNewSize;
+
+        SimpleVectorStaticData::recordGrow(_tag,
+                                           block_size,
+                                           _used_size * elementSize());
+
+        if (auto callback = SimpleVectorStaticData::_static_grow_callback
+                .load(std::memory_order_relaxed)) {
+            callback();
+        }
+        if (_grow_callback) {
+            _grow_callback();
+        }
+    }
+
+private:
+    static constexpr size_t elementSize () {
+        return (sizeof(Fields) + ...);
+    }
+
+    // fields follow each other, each starting at an aligned offset
+    static size_t blockSize (const size_t pCapacity) {
+        size_t offset = 0;
+        ((offset = detail::alignUp(offset, FIELD_ALIGNMENT)
+                   + pCapacity * sizeof(Fields)), ...);
+        return std::max(offset, size_t(1));
+    }
+
+    template <size_t... Is>
+    static void assignFields (std::tuple<Fields*...> &pFields,
+                              char *pBlock,
+                              const size_t pCapacity,
+                              std::index_sequence<Is...>) {
+        size_t offset = 0;
+        ((offset = detail::alignUp(offset, FIELD_ALIGNMENT),
+          std::get<Is>(pFields) = reinterpret_cast<Fields*>(pBlock + offset),
+          offset += pCapacity * sizeof(Fields)), ...);
+    }
+
+    template <size_t... Is>
+    void copyFields (std::tuple<Fields*...> &pTo,
+                     std::index_sequence<Is...>) const {
+        if (_used_size) {
+            (std::memcpy(std::get<Is>(pTo),
+                         std::get<Is>(_fields),
+                         _used_size * sizeof(Fields)), ...);
+        }
+    }
+
+    template <size_t... Is>
+    std::tuple<Fields&...> refs (const size_t pNum,
+                                 std::index_sequence<Is...>) {
+        return std::tie(std::get<Is>(_fields)[pNum]...);
+    }
+
+    template <size_t... Is>
+    value_type values (const size_t pNum, std::index_sequence<Is...>) const {
+        return value_type(std::get<Is>(_fields)[pNum]...);
+    }
+
+    void release () {
+        if (_block) {
+            HeapAllocator().deallocate(_block, _blockSize, FIELD_ALIGNMENT);
+        }
+        _block = nullptr;
+        _blockSize = 0;
+        _allocated_size = 0;
+        _fields = std::tuple<Fields*...>();
+    }
+
+    std::tuple<Fields*...> _fields;
+    char *_block = nullptr;
+    size_t _blockSize = 0;
+    size_t _used_size = 0;
+    size_t _allocated_size = 0;
+    void (*_grow_callback) (void) = nullptr;
+    const char *_tag = nullptr;
+};
+
+} // namespace VcppBits
+
+#endif // VcppBits_SIMPLE_VECTOR_SOA_VECTOR_HPP_INCLUDED__
@@ -0,0 +1,208 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_ASCII_CASE_HPP_INCLUDED__
+#define VcppBits_ASCII_CASE_HPP_INCLUDED__
+
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define VcppBits_ASCII_CASE_SSE2
+#include <emmintrin.h>
+#endif
+
+
+// Locale-independent ASCII case folding. Bytes outside of A-Z/a-z (including
+// UTF-8 sequences) are left as is.
+
+namespace VcppBits {
+namespace StringUtils {
+
+constexpr char toLowerAscii (const char pChar) {
+    return (pChar >= 'A' && pChar <= 'Z') ? char(pChar | 0x20) : pChar;
+}
+
+constexpr char toUpperAscii (const char pChar) {
+    return (pChar >= 'a' && pChar <= 'z') ? char(pChar & ~0x20) : pChar;
+}
+
+
+namespace detail {
+
+#ifdef VcppBits_ASCII_CASE_SSE2
+// 0x20 in every byte that is within [pFrom, pTo], 0 elsewhere.
+// Bytes >= 0x80 are negative for the signed comparisons, so never match
+inline __m128i asciiCaseBit (const __m128i pChars,
+                             const char pFrom,
+                             const char pTo) {
+    const __m128i in_range =
+        _mm_and_si128(_mm_cmpgt_epi8(pChars, _mm_set1_epi8(char(pFrom - 1))),
+                      _mm_cmplt_epi8(pChars, _mm_set1_epi8(char(pTo + 1))));
+    return _mm_and_si128(in_range, _mm_set1_epi8(0x20));
+}
+
+inline __m128i toLowerAscii16 (const __m128i pChars) {
+    return _mm_or_si128(pChars, asciiCaseBit(pChars, 'A', 'Z'));
+}
+#endif
+
+template <bool ToLower>
+inline void convertAscii (char *pString, const size_t pSize) {
+    size_t i = 0;
+#ifdef VcppBits_ASCII_CASE_SSE2
+    for (; i + 16 <= pSize; i += 16) {
+        __m128i *ptr = reinterpret_cast<__m128i*>(pString + i);
+        const __m128i chars = _mm_loadu_si128(ptr);
+        _mm_storeu_si128(ptr,
+                         ToLower
+                         ? _mm_or_si128(chars, asciiCaseBit(chars, 'A', 'Z'))
+                         : _mm_xor_si128(chars, asciiCaseBit(chars, 'a', 'z')));
+    }
+#endif
+    for (; i < pSize; ++i) {
+        pString[i] = ToLower ? toLowerAscii(pString[i])
+                             : toUpperAscii(pString[i]);
+    }
+}
+
+// length of the common case-insensitive prefix of two same-sized strings
+inline size_t mismatchIgnoreCase (const char *pA,
+                                  const char *pB,
+                                  const size_t pSize) {
+    size_t i = 0;
+#ifdef VcppBits_ASCII_CASE_SSE2
+    for (; i + 16 <= pSize; i += 16) {
+        const __m128i a = toLowerAscii16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(pA + i)));
+        const __m128i b = toLowerAscii16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(pB + i)));
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+        if (mask != 0xFFFF) {
+            unsigned diff = unsigned(~mask) & 0xFFFFu;
+            while (!(diff & 1u)) {
+                diff >>= 1;
+                ++i;
+            }
+            return i;
+        }
+    }
+#endif
+    for (; i < pSize; ++i) {
+        if (toLowerAscii(pA[i]) != toLowerAscii(pB[i])) {
+            break;
+        }
+    }
+    return i;
+}
+
+} // namespace detail
+
+
+inline void lowercase (std::string &pString) {
+    detail::convertAscii<true>(pString.data(), pString.size());
+}
+
+inline void uppercase (std::string &pString) {
+    detail::convertAscii<false>(pString.data(), pString.size());
+}
+
+inline std::string lowercased (const std::string_view pString) {
+    std::string ret(pString);
+    lowercase(ret);
+    return ret;
+}
+
+inline std::string uppercased (const std::string_view pString) {
+    std::string ret(pString);
+    uppercase(ret);
+    return ret;
+}
+
+inline bool equalsIgnoreCase (const std::string_view pA,
+                              const std::string_view pB) {
+    return pA.size() == pB.size()
+        && detail::mismatchIgnoreCase(pA.data(), pB.data(), pA.size())
+           == pA.size();
+}
+
+// <0, 0, >0 like std::string::compare(), on lowercased strings
+inline int compareIgnoreCase (const std::string_view pA,
+                              const std::string_view pB) {
+    const size_t common = std::min(pA.size(), pB.size());
+    const size_t pos = detail::mismatchIgnoreCase(pA.data(), pB.data(), common);
+    if (pos < common) {
+        const auto a = static_cast<unsigned char>(toLowerAscii(pA[pos]));
+        const auto b = static_cast<unsigned char>(toLowerAscii(pB[pos]));
+        return a < b ? -1 : 1;
+    }
+    if (pA.size() == pB.size()) {
+        return 0;
+    }
+    return pA.size() < pB.size() ? -1 : 1;
+}
+
+// hash() of the lowercased string
+constexpr std::uint64_t hashIgnoreCase (const std::string_view pString) {
+    std::uint64_t ret = 0xcbf29ce484222325ull;
+    for (const char c : pString) {
+        ret ^= std::uint64_t(static_cast<unsigned char>(toLowerAscii(c)));
+        ret *= 0x100000001b3ull;
+    }
+    return ret;
+}
+
+
+// for std::unordered_map<std::string, T, IgnoreCaseHash, IgnoreCaseEqual>
+// and std::map<std::string, T, IgnoreCaseLess>
+struct IgnoreCaseHash {
+    size_t operator() (const std::string_view pString) const noexcept {
+        return static_cast<size_t>(hashIgnoreCase(pString));
+    }
+};
+
+struct IgnoreCaseEqual {
+    bool operator() (const std::string_view pA,
+                     const std::string_view pB) const noexcept {
+        return equalsIgnoreCase(pA, pB);
+    }
+};
+
+struct IgnoreCaseLess {
+    using is_transparent = void;
+    bool operator() (const std::string_view pA,
+                     const std::string_view pB) const noexcept {
+        return compareIgnoreCase(pA, pB) < 0;
+    }
+};
+
+} // namespace StringUtils
+} // namespace VcppBits
+
+
+#endif // VcppBits_ASCII_CASE_HPP_INCLUDED__
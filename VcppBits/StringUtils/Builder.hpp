@@ -0,0 +1,220 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_BUILDER_HPP_INCLUDED__
+#define VcppBits_BUILDER_HPP_INCLUDED__
+
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+
+namespace VcppBits {
+namespace StringUtils {
+
+// Growable char buffer to format output without iostreams: numbers are
+// printed with std::to_chars, so there is no sentry or locale overhead
+class Builder {
+public:
+    explicit Builder (const size_t pReserve = 0) {
+        reserve(pReserve);
+    }
+
+    void reserve (const size_t pCapacity) {
+        if (pCapacity > _capacity) {
+            std::unique_ptr<char[]> new_data(new char[pCapacity]);
+            if (_size) {
+                std::memcpy(new_data.get(), _data.get(), _size);
+            }
+            _data = std::move(new_data);
+            _capacity = pCapacity;
+        }
+    }
+
+    Builder& append (const std::string_view pString) {
+        if (!pString.empty()) {
+            std::memcpy(grab(pString.size()), pString.data(), pString.size());
+        }
+        return *this;
+    }
+
+    Builder& append (const char pChar) {
+        *grab(1) = pChar;
+        return *this;
+    }
+
+    // "1"/"0", same as iostreams print bools by default. (Template, so that
+    // pointers, e.g. string literals, don't get converted to bool)
+    template <typename T>
+    typename std::enable_if<std::is_same<T, bool>::value, Builder&>::type
+    append (const T pBool) {
+        return append(pBool ? '1' : '0');
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value
+                            && !std::is_same<T, char>::value
+                            && !std::is_same<T, bool>::value,
+                            Builder&>::type
+    append (const T pValue) {
+        ensureFree(24);
+        const auto res = std::to_chars(end(), capacityEnd(), pValue);
+        _size = size_t(res.ptr - _data.get());
+        return *this;
+    }
+
+    // shortest representation that reads back to the same value
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, Builder&>::type
+    append (const T pValue) {
+        return appendFloat([pValue] (char *pFirst, char *pLast) {
+            return std::to_chars(pFirst, pLast, pValue);
+        });
+    }
+
+    // same as "ss << std::fixed << std::setprecision(pPrecision) << pValue"
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, Builder&>::type
+    appendFixed (const T pValue, const int pPrecision = 6) {
+        return appendFloat([pValue, pPrecision] (char *pFirst, char *pLast) {
+            return std::to_chars(pFirst,
+                                 pLast,
+                                 pValue,
+                                 std::chars_format::fixed,
+                                 pPrecision);
+        });
+    }
+
+    template <typename T>
+    Builder& operator<< (const T &pValue) {
+        return append(pValue);
+    }
+
+    const char* data () const {
+        return _data.get();
+    }
+
+    size_t size () const {
+        return _size;
+    }
+
+    size_t capacity () const {
+        return _capacity;
+    }
+
+    std::string_view view () const {
+        return std::string_view(_data.get(), _size);
+    }
+
+    std::string str () const {
+        return std::string(_data.get(), _size);
+    }
+
+    void clear () {
+        _size = 0;
+    }
+
+    // writes everything to the file descriptor and clears the buffer;
+    // returns false on write error (errno is left set)
+    bool flush (const int pFd) {
+        const char *ptr = _data.get();
+        size_t left = _size;
+        while (left) {
+#ifdef _WIN32
+            const auto written = ::_write(pFd, ptr, unsigned(left));
+#else
+            const auto written = ::write(pFd, ptr, left);
+#endif
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            ptr += written;
+            left -= size_t(written);
+        }
+        clear();
+        return true;
+    }
+
+private:
+    char* end () {
+        return _data.get() + _size;
+    }
+
+    char* capacityEnd () {
+        return _data.get() + _capacity;
+    }
+
+    void ensureFree (const size_t pSize) {
+        if (_capacity - _size < pSize) {
+            reserve(std::max(_capacity * 2, _size + pSize));
+        }
+    }
+
+    char* grab (const size_t pSize) {
+        ensureFree(pSize);
+        char *ret = end();
+        _size += pSize;
+        return ret;
+    }
+
+    template <typename ToCharsT>
+    Builder& appendFloat (ToCharsT pToChars) {
+        ensureFree(32);
+        for (;;) {
+            const auto res = pToChars(end(), capacityEnd());
+            if (res.ec == std::errc()) {
+                _size = size_t(res.ptr - _data.get());
+                return *this;
+            }
+            // only happens to huge numbers in fixed notation
+            reserve(_capacity * 2);
+        }
+    }
+
+    std::unique_ptr<char[]> _data;
+    size_t _size = 0;
+    size_t _capacity = 0;
+};
+
+} // namespace StringUtils
+} // namespace VcppBits
+
+
+#endif // VcppBits_BUILDER_HPP_INCLUDED__
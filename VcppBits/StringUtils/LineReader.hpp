@@ -0,0 +1,165 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_LINE_READER_HPP_INCLUDED__
+#define VcppBits_LINE_READER_HPP_INCLUDED__
+
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <istream>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+
+namespace VcppBits {
+namespace StringUtils {
+
+// Block-buffered replacement for safeGetline(). Line endings are handled the
+// same way: "\n", "\r\n" and "\r" all terminate a line, and the last line is
+// returned even if it has no terminator.
+//
+// Lines are returned as views into the internal buffer, which are only valid
+// until the next getLine() call.
+class LineReader {
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+    explicit LineReader (std::istream &pStream,
+                         const size_t pBufferSize = DEFAULT_BUFFER_SIZE)
+        : _stream (&pStream),
+          _buffer (std::max<size_t>(pBufferSize, 1)) {
+    }
+
+    explicit LineReader (const int pFd,
+                         const size_t pBufferSize = DEFAULT_BUFFER_SIZE)
+        : _fd (pFd),
+          _buffer (std::max<size_t>(pBufferSize, 1)) {
+    }
+
+    bool getLine (std::string_view &pLine) {
+        size_t scan_from = _begin;
+
+        for (;;) {
+            const char *buf = _buffer.data();
+            const char *start = buf + scan_from;
+            const char *stop = buf + _end;
+
+            const char *nl = static_cast<const char*>(
+                std::memchr(start, '\n', size_t(stop - start)));
+            const char *limit = nl ? nl : stop;
+            const char *cr = static_cast<const char*>(
+                std::memchr(start, '\r', size_t(limit - start)));
+            const char *term = cr ? cr : nl;
+
+            // a '\r' ending the buffer may be the first half of "\r\n"
+            if (term && !(term == cr && term + 1 == stop && !_eof)) {
+                pLine = std::string_view(buf + _begin,
+                                         size_t(term - (buf + _begin)));
+                _begin = size_t(term - buf) + 1;
+                if (term == cr && _begin < _end && buf[_begin] == '\n') {
+                    ++_begin;
+                }
+                return true;
+            }
+
+            if (_eof) {
+                if (_begin == _end) {
+                    return false;
+                }
+                pLine = std::string_view(buf + _begin, _end - _begin);
+                _begin = _end;
+                return true;
+            }
+
+            scan_from = (term ? size_t(term - buf) : _end) - _begin;
+            fill();
+        }
+    }
+
+private:
+    void fill () {
+        if (_begin > 0) {
+            std::memmove(_buffer.data(), _buffer.data() + _begin, _end - _begin);
+            _end -= _begin;
+            _begin = 0;
+        }
+        if (_end == _buffer.size()) {
+            _buffer.resize(_buffer.size() * 2);
+        }
+
+        const size_t got = read(_buffer.data() + _end, _buffer.size() - _end);
+        if (got == 0) {
+            _eof = true;
+        }
+        _end += got;
+    }
+
+    size_t read (char *pDest, const size_t pSize) {
+        if (_stream) {
+            const auto got =
+                _stream->rdbuf()->sgetn(pDest, std::streamsize(pSize));
+            return got > 0 ? size_t(got) : 0;
+        }
+
+        for (;;) {
+#ifdef _WIN32
+            const auto got = ::_read(_fd, pDest, unsigned(pSize));
+#else
+            const auto got = ::read(_fd, pDest, pSize);
+#endif
+            if (got >= 0) {
+                return size_t(got);
+            }
+            if (errno != EINTR) {
+                throw std::system_error(errno,
+                                        std::generic_category(),
+                                        "LineReader: read failed");
+            }
+        }
+    }
+
+    std::istream *_stream = nullptr;
+    int _fd = -1;
+
+    std::vector<char> _buffer;
+    size_t _begin = 0;
+    size_t _end = 0;
+    bool _eof = false;
+};
+
+} // namespace StringUtils
+} // namespace VcppBits
+
+
+#endif // VcppBits_LINE_READER_HPP_INCLUDED__
@@ -0,0 +1,133 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_PARSE_NUMBERS_HPP_INCLUDED__
+#define VcppBits_PARSE_NUMBERS_HPP_INCLUDED__
+
+
+#include <charconv>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+
+namespace VcppBits {
+namespace StringUtils {
+
+namespace detail {
+
+// ASCII whitespace, ',' and ';' separate numbers in a list
+struct NumberDelimiters {
+    constexpr NumberDelimiters () : table () {
+        for (const char c : std::string_view(" \t\n\v\f\r,;")) {
+            table[static_cast<unsigned char>(c)] = true;
+        }
+    }
+    bool table[256];
+};
+
+inline bool isNumberDelimiter (const char pChar) {
+    static constexpr NumberDelimiters delimiters;
+    return delimiters.table[static_cast<unsigned char>(pChar)];
+}
+
+template <typename T>
+std::from_chars_result parseNumber (const char *pFirst,
+                                    const char *pLast,
+                                    T &pValue) {
+    // from_chars() doesn't accept the explicit plus sign, stringstream does
+    if (pFirst != pLast && *pFirst == '+' && pLast - pFirst > 1
+        && pFirst[1] != '-') {
+        ++pFirst;
+    }
+    if constexpr (std::is_floating_point<T>::value) {
+        return std::from_chars(pFirst, pLast, pValue,
+                               std::chars_format::general);
+    }
+    else {
+        return std::from_chars(pFirst, pLast, pValue);
+    }
+}
+
+} // namespace detail
+
+
+// Parses up to pMaxCount numbers from a whitespace/','/';'-separated list in
+// a single pass, without going through streams. Stops at the first token
+// that isn't a number of type T. Returns the count of stored numbers.
+template <typename T>
+size_t parseNumbers (const std::string_view pString,
+                     T *pOut,
+                     const size_t pMaxCount) {
+    static_assert(std::is_arithmetic<T>::value
+                  && !std::is_same<T, bool>::value,
+                  "parseNumbers() only parses ints and floats");
+    const char *ptr = pString.data();
+    const char *end = ptr + pString.size();
+    size_t count = 0;
+
+    while (count < pMaxCount) {
+        while (ptr != end && detail::isNumberDelimiter(*ptr)) {
+            ++ptr;
+        }
+        if (ptr == end) {
+            break;
+        }
+
+        const auto res = detail::parseNumber(ptr, end, pOut[count]);
+        if (res.ec != std::errc()
+            || (res.ptr != end && !detail::isNumberDelimiter(*res.ptr))) {
+            break;
+        }
+        ++count;
+        ptr = res.ptr;
+    }
+
+    return count;
+}
+
+template <typename T, size_t N>
+size_t parseNumbers (const std::string_view pString, T (&pOut)[N]) {
+    return parseNumbers(pString, pOut, N);
+}
+
+// appends all the numbers it could parse to pOut
+template <typename T>
+size_t parseNumbers (const std::string_view pString, std::vector<T> &pOut) {
+    const size_t old_size = pOut.size();
+    // every number takes at least two chars, including the delimiter
+    pOut.resize(old_size + pString.size() / 2 + 1);
+    const size_t count = parseNumbers(pString,
+                                      pOut.data() + old_size,
+                                      pOut.size() - old_size);
+    pOut.resize(old_size + count);
+    return count;
+}
+
+} // namespace StringUtils
+} // namespace VcppBits
+
+
+#endif // VcppBits_PARSE_NUMBERS_HPP_INCLUDED__
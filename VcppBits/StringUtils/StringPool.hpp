@@ -0,0 +1,128 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_STRING_POOL_HPP_INCLUDED__
+#define VcppBits_STRING_POOL_HPP_INCLUDED__
+
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "VcppBits/StringUtils/Symbol.hpp"
+
+
+namespace VcppBits {
+namespace StringUtils {
+
+struct StringPoolStats {
+    size_t lookups = 0;
+    size_t hits = 0;
+    size_t uniqueStrings = 0;
+    size_t bytesStored = 0;
+    // bytes that would have been spent on copies if strings weren't interned
+    size_t bytesSaved = 0;
+
+    double hitRate () const {
+        return lookups ? double(hits) / double(lookups) : 0.;
+    }
+};
+
+// Thread-safe string interner. Every distinct string is stored once, and
+// intern() returns a view of that single copy, so interned strings can be
+// compared by data() pointer. Views stay valid for the pool's lifetime.
+class StringPool {
+public:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    StringPool () = default;
+    StringPool (const StringPool&) = delete;
+    StringPool& operator= (const StringPool&) = delete;
+
+    // process-wide pool, shared by all the components
+    static StringPool& global () {
+        static StringPool pool;
+        return pool;
+    }
+
+    std::string_view intern (const std::string_view pString) {
+        const Symbol key(pString);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_stats.lookups;
+
+        const auto it = _strings.find(key);
+        if (it != _strings.end()) {
+            ++_stats.hits;
+            _stats.bytesSaved += pString.size();
+            return it->view();
+        }
+
+        const std::string_view stored = store(pString);
+        _strings.emplace(stored);
+        ++_stats.uniqueStrings;
+        _stats.bytesStored += stored.size();
+        return stored;
+    }
+
+    Symbol internSymbol (const std::string_view pString) {
+        return Symbol(intern(pString));
+    }
+
+    StringPoolStats getStats () const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _stats;
+    }
+
+private:
+    std::string_view store (const std::string_view pString) {
+        if (_chunks.empty() || pString.size() > _chunkSize - _chunkPos) {
+            _chunkSize = std::max(CHUNK_SIZE, pString.size());
+            _chunkPos = 0;
+            _chunks.emplace_back(new char[_chunkSize]);
+        }
+        char *dest = _chunks.back().get() + _chunkPos;
+        std::memcpy(dest, pString.data(), pString.size());
+        _chunkPos += pString.size();
+        return std::string_view(dest, pString.size());
+    }
+
+    mutable std::mutex _mutex;
+    std::unordered_set<Symbol> _strings;
+    std::vector<std::unique_ptr<char[]>> _chunks;
+    size_t _chunkSize = 0;
+    size_t _chunkPos = 0;
+    StringPoolStats _stats;
+};
+
+} // namespace StringUtils
+} // namespace VcppBits
+
+
+#endif // VcppBits_STRING_POOL_HPP_INCLUDED__
@@ -27,12 +27,14 @@
 
 
 #include <string>
+#include <string_view>
 #include <algorithm>
 #include <sstream>
 #include <vector>
 #include <codecvt>
 #include <locale>
 
+#include "VcppBits/StringUtils/AsciiCase.hpp"
 
 namespace VcppBits {
 namespace StringUtils {
@@ -85,6 +87,19 @@ inline std::string trim (const std::string &pString,
     return pString.substr(beginStr, range);
 }
 
+// same as trim(), but doesn't allocate: returns a view into pString
+inline std::string_view trimView (const std::string_view pString,
+                                  const std::string_view pWhitespace = " \t") {
+    const size_t beginStr = pString.find_first_not_of(pWhitespace);
+
+    if (beginStr == std::string_view::npos) {
+        return std::string_view();
+    }
+
+    const size_t endStr = pString.find_last_not_of(pWhitespace);
+    return pString.substr(beginStr, endStr - beginStr + 1);
+}
+
 inline std::string reduce (const std::string &pString,
                            const std::string &pFill = " ",
                            const std::string &pWhitespace = " \t") {
@@ -110,13 +125,13 @@ inline std::string capitalized (const std::string &str) {
     std::string ret_str = str;
 
     if (ret_str.length() > 0) {
-        ret_str[0] = toupper(ret_str[0]);
+        ret_str[0] = toUpperAscii(ret_str[0]);
     }
     return ret_str;
 }
 
 inline void capitalize (std::string &str) {
-    str[0] = toupper(str[0]);
+    str[0] = toUpperAscii(str[0]);
 }
 
 
@@ -0,0 +1,284 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Micro-benchmarks of StringUtils functions over KeyFile-like and
+// translation-like corpora.
+//
+// usage: stringutils-bench [KEYFILE_CORPUS [TRANSLATION_CORPUS]]
+//
+// By default the KeyFile corpus is VcppBits/KeyFile/README (the format
+// example we ship), and the translation corpus is generated.
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "VcppBits/StringUtils/LineReader.hpp"
+#include "VcppBits/StringUtils/StringUtils.hpp"
+
+using namespace VcppBits::StringUtils;
+
+namespace {
+
+// keeps the optimizer from throwing the benchmarked work away
+volatile size_t g_sink = 0;
+
+template <typename FuncT>
+void bench (const char *pName,
+            const size_t pOpsPerRun,
+            const size_t pBytesPerRun,
+            FuncT pFunc) {
+    using clock = std::chrono::steady_clock;
+    constexpr double min_seconds = 0.2;
+
+    pFunc(); // warmup
+
+    size_t runs = 0;
+    double seconds = 0.;
+    const auto start = clock::now();
+    do {
+        pFunc();
+        ++runs;
+        seconds = std::chrono::duration<double>(clock::now() - start).count();
+    } while (seconds < min_seconds);
+
+    const double ops = double(runs) * double(pOpsPerRun);
+    const double bytes = double(runs) * double(pBytesPerRun);
+    std::printf("%-32s %12.2f ns/op %12.2f MB/s\n",
+                pName,
+                seconds * 1e9 / ops,
+                bytes / seconds / 1e6);
+}
+
+std::string readFile (const std::string &pFileName) {
+    std::ifstream file(pFileName, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("couldn't open " + pFileName);
+    }
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+std::string repeatToSize (const std::string &pText, const size_t pSize) {
+    std::string ret;
+    ret.reserve(pSize + pText.size());
+    while (ret.size() < pSize) {
+        ret += pText;
+    }
+    return ret;
+}
+
+std::string generateTranslationCorpus () {
+    const char *phrases[] = {
+        "Settings",
+        "Press %key to continue",
+        "Настройки графики",
+        "Громкость: %value%",
+        "Level %num of %total completed in %time seconds",
+        "Einstellungen übernehmen",
+    };
+    std::string ret;
+    for (size_t i = 0; i < 200; ++i) {
+        ret += "STRING_ID_" + std::to_string(i) + "   "
+            + phrases[i % (sizeof(phrases) / sizeof(phrases[0]))] + "\r\n";
+    }
+    return ret;
+}
+
+std::vector<std::string> splitLines (const std::string &pText) {
+    std::istringstream is(pText);
+    std::vector<std::string> ret;
+    std::string line;
+    while (!safeGetline(is, line).eof() || !is.fail()) {
+        ret.push_back(line);
+    }
+    return ret;
+}
+
+size_t totalSize (const std::vector<std::string> &pLines) {
+    size_t ret = 0;
+    for (const auto &l : pLines) {
+        ret += l.size();
+    }
+    return ret;
+}
+
+void benchLines (const std::string &pCorpusName, const std::string &pText) {
+    const auto lines = splitLines(pText);
+    const size_t bytes = totalSize(lines);
+    const std::string prefix = pCorpusName + ": ";
+
+    std::printf("\n%s corpus: %zu lines, %zu bytes\n",
+                pCorpusName.c_str(), lines.size(), pText.size());
+
+    bench((prefix + "safeGetline").c_str(), lines.size(), pText.size(), [&] {
+        std::istringstream is(pText);
+        std::string line;
+        while (!safeGetline(is, line).eof() || !is.fail()) {
+            g_sink = g_sink + line.size();
+        }
+    });
+
+    bench((prefix + "LineReader").c_str(), lines.size(), pText.size(), [&] {
+        std::istringstream is(pText);
+        LineReader reader(is);
+        std::string_view line;
+        while (reader.getLine(line)) {
+            g_sink = g_sink + line.size();
+        }
+    });
+
+    bench((prefix + "trim").c_str(), lines.size(), bytes, [&] {
+        for (const auto &l : lines) {
+            g_sink = g_sink + trim(l).size();
+        }
+    });
+
+    bench((prefix + "trimView").c_str(), lines.size(), bytes, [&] {
+        for (const auto &l : lines) {
+            g_sink = g_sink + trimView(l).size();
+        }
+    });
+
+    bench((prefix + "reduce").c_str(), lines.size(), bytes, [&] {
+        for (const auto &l : lines) {
+            g_sink = g_sink + reduce(l).size();
+        }
+    });
+
+    bench((prefix + "Tokenizer").c_str(), lines.size(), bytes, [&] {
+        for (const auto &l : lines) {
+            Tokenizer tok(l);
+            g_sink = g_sink + tok.getNumWords();
+        }
+    });
+
+    bench((prefix + "toUtf32").c_str(), lines.size(), bytes, [&] {
+        for (const auto &l : lines) {
+            g_sink = g_sink + toUtf32(l).size();
+        }
+    });
+
+    std::vector<std::wstring> wide;
+    for (const auto &l : lines) {
+        std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> conv;
+        wide.push_back(conv.from_bytes(l));
+    }
+    bench((prefix + "toUtf8").c_str(), lines.size(), bytes, [&] {
+        for (const auto &w : wide) {
+            g_sink = g_sink + toUtf8(w).size();
+        }
+    });
+}
+
+template <typename T>
+void benchConversions (const char *pTypeName, const std::vector<T> &pValues) {
+    std::vector<std::string> strings;
+    for (const auto v : pValues) {
+        strings.push_back(toString<T>(v));
+    }
+    const size_t bytes = totalSize(strings);
+
+    bench((std::string("toString<") + pTypeName + ">").c_str(),
+          pValues.size(), bytes, [&] {
+              for (const auto v : pValues) {
+                  g_sink = g_sink + toString<T>(v).size();
+              }
+          });
+
+    bench((std::string("fromString<") + pTypeName + ">").c_str(),
+          strings.size(), bytes, [&] {
+              for (const auto &s : strings) {
+                  g_sink = g_sink + size_t(fromString<T>(s) != T{});
+              }
+          });
+}
+
+template <typename T>
+std::vector<T> sampleValues () {
+    std::vector<T> ret;
+    for (int i = 0; i < 1000; ++i) {
+        if constexpr (std::is_same<T, bool>::value) {
+            ret.push_back(i % 2);
+        }
+        else if constexpr (std::is_floating_point<T>::value) {
+            ret.push_back(T(i) * T(3.14159) - T(1000));
+        }
+        else if constexpr (std::is_signed<T>::value) {
+            ret.push_back(T((i * 7919) % 127 - 63));
+        }
+        else {
+            ret.push_back(T((i * 7919) % 255));
+        }
+    }
+    return ret;
+}
+
+void benchAllConversions () {
+    std::printf("\nfromString/toString, 1000 values each\n");
+    benchConversions("bool", sampleValues<bool>());
+    benchConversions("short", sampleValues<short>());
+    benchConversions("unsigned short", sampleValues<unsigned short>());
+    benchConversions("int", sampleValues<int>());
+    benchConversions("unsigned", sampleValues<unsigned>());
+    benchConversions("long", sampleValues<long>());
+    benchConversions("unsigned long", sampleValues<unsigned long>());
+    benchConversions("long long", sampleValues<long long>());
+    benchConversions("unsigned long long",
+                     sampleValues<unsigned long long>());
+    benchConversions("float", sampleValues<float>());
+    benchConversions("double", sampleValues<double>());
+    benchConversions("long double", sampleValues<long double>());
+}
+
+} // namespace (anonymous)
+
+
+int main (int argc, char **argv) {
+    constexpr size_t corpus_size = 1024 * 1024;
+
+    const std::string keyfile_corpus = argc > 1
+        ? readFile(argv[1])
+        : repeatToSize(readFile(VcppBits_KEYFILE_README), corpus_size);
+    const std::string translation_corpus = argc > 2
+        ? readFile(argv[2])
+        : repeatToSize(generateTranslationCorpus(), corpus_size);
+
+    benchLines("KeyFile", keyfile_corpus);
+    benchLines("Translation", translation_corpus);
+    benchAllConversions();
+
+    return 0;
+}
@@ -0,0 +1,309 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <cstdio>
+#include <sstream>
+#include <thread>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <VcppBits/contrib/catch2/catch.hpp>
+
+#include "AsciiCase.hpp"
+#include "Builder.hpp"
+#include "LineReader.hpp"
+#include "ParseNumbers.hpp"
+#include "StringPool.hpp"
+#include "StringUtils.hpp"
+#include "Symbol.hpp"
+
+using namespace VcppBits::StringUtils;
+
+namespace {
+
+std::vector<std::string> read_with_safe_getline (const std::string &pText) {
+    std::istringstream is(pText);
+    std::vector<std::string> ret;
+    std::string str;
+    while (!safeGetline(is, str).eof() || !is.fail()) {
+        ret.push_back(str);
+    }
+    // safeGetline() loop yields one trailing empty line after the last one
+    if (!ret.empty() && ret.back().empty()) {
+        ret.pop_back();
+    }
+    return ret;
+}
+
+std::vector<std::string> read_with_line_reader (const std::string &pText,
+                                                const size_t pBufferSize) {
+    std::istringstream is(pText);
+    LineReader reader(is, pBufferSize);
+    std::vector<std::string> ret;
+    std::string_view line;
+    while (reader.getLine(line)) {
+        ret.emplace_back(line);
+    }
+    return ret;
+}
+
+} // namespace (anonymous)
+
+
+TEST_CASE("LineReader splits lines like safeGetline", "[LineReader]") {
+    const std::vector<std::string> texts {
+        "",
+        "\n",
+        "one",
+        "one\ntwo\n",
+        "one\r\ntwo\r\nthree",
+        "one\rtwo\r\rthree\r",
+        "mixed\r\n\n\r\rending\n\r",
+        "a much longer line that doesn't fit in a tiny buffer\r\nshort\r"
+    };
+
+    for (const auto &text : texts) {
+        const auto expected = read_with_safe_getline(text);
+        const std::vector<size_t> buffer_sizes {
+            1, 2, 3, 7, LineReader::DEFAULT_BUFFER_SIZE
+        };
+        for (const size_t buffer_size : buffer_sizes) {
+            CHECK(read_with_line_reader(text, buffer_size) == expected);
+        }
+    }
+}
+
+TEST_CASE("LineReader keeps empty lines", "[LineReader]") {
+    const std::vector<std::string> expected { "", "a", "", "b" };
+    CHECK(read_with_line_reader("\na\n\r\nb", 2) == expected);
+}
+
+TEST_CASE("LineReader reads from a file descriptor", "[LineReader]") {
+    std::FILE *file = std::tmpfile();
+    REQUIRE(file);
+    const std::string text = "[section]\r\nfoo 1\nbar 2";
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fflush(file);
+    std::rewind(file);
+
+    LineReader reader(fileno(file), 4);
+    std::vector<std::string> lines;
+    std::string_view line;
+    while (reader.getLine(line)) {
+        lines.emplace_back(line);
+    }
+    std::fclose(file);
+
+    CHECK(lines == std::vector<std::string>{ "[section]", "foo 1", "bar 2" });
+}
+
+TEST_CASE("trimView", "[StringUtils]") {
+    CHECK(trimView("  \tfoo bar \t") == "foo bar");
+    CHECK(trimView(" \t ").empty());
+    CHECK(trimView("xxfooxx", "x") == "foo");
+}
+
+TEST_CASE("constexpr hash", "[Symbol]") {
+    static_assert(hash("") == 0xcbf29ce484222325ull);
+    static_assert(hash("a") == 0xaf63dc4c8601ec8cull);
+    CHECK(hash(std::string("graphics.width")) == hash("graphics.width"));
+    CHECK(hash("graphics.width") != hash("graphics.height"));
+}
+
+TEST_CASE("Symbol", "[Symbol]") {
+    using namespace SymbolLiterals;
+    constexpr Symbol width = "graphics.width"_sym;
+    static_assert(width.getHash() == hash("graphics.width"));
+
+    const std::string width_str = "graphics.width";
+    CHECK(Symbol(width_str) == width);
+    CHECK(Symbol("graphics.height") != width);
+    CHECK(width.toString() == width_str);
+
+    std::unordered_map<Symbol, int> map;
+    map[width] = 1;
+    map["graphics.height"] = 2;
+    CHECK(map.at(Symbol(width_str)) == 1);
+    CHECK(map.at("graphics.height") == 2);
+}
+
+TEST_CASE("StringPool interns strings", "[StringPool]") {
+    StringPool pool;
+    const std::string a = "graphics.width";
+    const std::string b = "graphics.width";
+
+    const auto ia = pool.intern(a);
+    const auto ib = pool.intern(b);
+    const auto ic = pool.intern("graphics.height");
+
+    CHECK(ia == a);
+    CHECK(ia.data() == ib.data());
+    CHECK(ia.data() != a.data());
+    CHECK(ic.data() != ia.data());
+    CHECK(pool.internSymbol(a) == Symbol(a));
+
+    const auto stats = pool.getStats();
+    CHECK(stats.lookups == 4);
+    CHECK(stats.hits == 2);
+    CHECK(stats.uniqueStrings == 2);
+    CHECK(stats.bytesStored == a.size() + ic.size());
+    CHECK(stats.bytesSaved == 2 * a.size());
+    CHECK(stats.hitRate() == Approx(0.5));
+}
+
+TEST_CASE("StringPool is thread-safe", "[StringPool]") {
+    StringPool pool;
+    const std::string long_str(StringPool::CHUNK_SIZE + 1, 'x');
+    std::vector<std::thread> threads;
+    std::vector<const char*> results(4);
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&, i] {
+            for (int j = 0; j < 1000; ++j) {
+                pool.intern(std::to_string(j));
+            }
+            results[i] = pool.intern(long_str).data();
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    CHECK(std::count(results.begin(), results.end(), results[0]) == 4);
+    CHECK(pool.getStats().uniqueStrings == 1001);
+    CHECK(pool.intern("999").data() == pool.intern("999").data());
+}
+
+TEST_CASE("Builder formats numbers and strings", "[Builder]") {
+    Builder b;
+    b << "int " << -42 << ' ' << size_t(18446744073709551615ull)
+      << " bool " << true << false
+      << " float " << 0.1f << ' ' << 2.5;
+    CHECK(b.view()
+          == "int -42 18446744073709551615 bool 10 float 0.1 2.5");
+
+    b.clear();
+    CHECK(b.size() == 0);
+    b.appendFixed(3.141593f).append(' ').appendFixed(1.f, 2);
+    CHECK(b.str() == "3.141593 1.00");
+
+    b.clear();
+    b.appendFixed(1e300);
+    CHECK(b.size() == 301 + 7);
+}
+
+TEST_CASE("Builder flushes to a file descriptor", "[Builder]") {
+    std::FILE *file = std::tmpfile();
+    REQUIRE(file);
+
+    Builder b(4);
+    const std::string long_str(100000, 'x');
+    b << long_str << '\n' << 12345;
+    REQUIRE(b.flush(fileno(file)));
+    CHECK(b.size() == 0);
+
+    std::rewind(file);
+    LineReader reader(fileno(file));
+    std::string_view line;
+    REQUIRE(reader.getLine(line));
+    CHECK(line == long_str);
+    REQUIRE(reader.getLine(line));
+    CHECK(line == "12345");
+    std::fclose(file);
+}
+
+TEST_CASE("ASCII case conversion", "[AsciiCase]") {
+    // long enough to go through the vectorized path and the tail
+    const std::string mixed = "Graphics.Width = 1920 [Section_Z] @`{ \xC3\x84 Abz";
+    CHECK(lowercased(mixed) == "graphics.width = 1920 [section_z] @`{ \xC3\x84 abz");
+    CHECK(uppercased(mixed) == "GRAPHICS.WIDTH = 1920 [SECTION_Z] @`{ \xC3\x84 ABZ");
+
+    std::string str = "MiXeD";
+    lowercase(str);
+    CHECK(str == "mixed");
+    uppercase(str);
+    CHECK(str == "MIXED");
+
+    CHECK(capitalized("foo") == "Foo");
+    CHECK(capitalized("") == "");
+}
+
+TEST_CASE("Case-insensitive comparison and hash", "[AsciiCase]") {
+    const std::string a = "section.Some_Rather_Long_Setting_Name";
+    const std::string b = "SECTION.some_rather_long_setting_name";
+
+    CHECK(equalsIgnoreCase(a, b));
+    CHECK_FALSE(equalsIgnoreCase(a, b + "x"));
+    CHECK_FALSE(equalsIgnoreCase("[", "{"));
+    CHECK(compareIgnoreCase(a, b) == 0);
+    CHECK(compareIgnoreCase("abc", "ABD") < 0);
+    CHECK(compareIgnoreCase("section.some_rather_long_setting_namf", b) > 0);
+    CHECK(compareIgnoreCase("ab", "ABC") < 0);
+    CHECK(compareIgnoreCase("B", "a") > 0);
+
+    static_assert(hashIgnoreCase("Foo") == hash("foo"));
+    CHECK(hashIgnoreCase(a) == hashIgnoreCase(b));
+
+    std::unordered_map<std::string, int, IgnoreCaseHash, IgnoreCaseEqual> map;
+    map[a] = 1;
+    CHECK(map.count(b) == 1);
+}
+
+TEST_CASE("parseNumbers parses delimited lists", "[ParseNumbers]") {
+    float floats[3];
+    CHECK(parseNumbers(" 0.1 -2.5e3\t+3 ", floats) == 3);
+    CHECK(floats[0] == Approx(0.1f));
+    CHECK(floats[1] == Approx(-2500.f));
+    CHECK(floats[2] == Approx(3.f));
+
+    int ints[4];
+    CHECK(parseNumbers("1,2;  3,,4, 5", ints) == 4);
+    CHECK(ints[3] == 4);
+
+    // stops at the first non-number
+    CHECK(parseNumbers("1 2 x 4", ints) == 2);
+    CHECK(parseNumbers("1 2.5", ints) == 1);
+    CHECK(parseNumbers("99999999999", ints) == 0);
+    CHECK(parseNumbers("", ints) == 0);
+}
+
+TEST_CASE("parseNumbers appends to vectors", "[ParseNumbers]") {
+    std::vector<double> values { 42. };
+    std::string str;
+    for (int i = 0; i < 1000; ++i) {
+        str += std::to_string(i) + ".5 ";
+    }
+    CHECK(parseNumbers(str, values) == 1000);
+    REQUIRE(values.size() == 1001);
+    CHECK(values[0] == 42.);
+    CHECK(values[1000] == 999.5);
+
+    std::vector<unsigned> one;
+    CHECK(parseNumbers("7", one) == 1);
+    CHECK(one == std::vector<unsigned>{ 7 });
+}
@@ -0,0 +1,124 @@
+// The MIT License (MIT)
+
+// Copyright 2020 Vitalii Minnakhmetov <restlessmonkey@ya.ru>
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef VcppBits_SYMBOL_HPP_INCLUDED__
+#define VcppBits_SYMBOL_HPP_INCLUDED__
+
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+
+namespace VcppBits {
+namespace StringUtils {
+
+// 64-bit FNV-1a. constexpr, so hashes of literals can be computed at compile
+// time
+constexpr std::uint64_t hash (const std::string_view pString) {
+    std::uint64_t ret = 0xcbf29ce484222325ull;
+    for (const char c : pString) {
+        ret ^= std::uint64_t(static_cast<unsigned char>(c));
+        ret *= 0x100000001b3ull;
+    }
+    return ret;
+}
+
+
+// string view together with its precomputed hash().
+// NOTE: Symbol doesn't own the string it refers to
+class Symbol {
+public:
+    constexpr Symbol (const char *pString)
+        : Symbol (std::string_view(pString)) {
+    }
+
+    constexpr Symbol (const std::string_view pString)
+        : _string (pString),
+          _hash (StringUtils::hash(pString)) {
+    }
+
+    Symbol (const std::string &pString)
+        : Symbol (std::string_view(pString)) {
+    }
+
+    constexpr std::string_view view () const {
+        return _string;
+    }
+
+    constexpr std::uint64_t getHash () const {
+        return _hash;
+    }
+
+    std::string toString () const {
+        return std::string(_string);
+    }
+
+    constexpr bool operator== (const Symbol &pOther) const {
+        return _hash == pOther._hash && _string == pOther._string;
+    }
+
+    constexpr bool operator!= (const Symbol &pOther) const {
+        return !(*this == pOther);
+    }
+
+private:
+    std::string_view _string;
+    std::uint64_t _hash;
+};
+
+
+// use as std::unordered_map<Symbol, T, SymbolHash>, no rehashing on lookups
+struct SymbolHash {
+    size_t operator() (const Symbol &pSymbol) const noexcept {
+        return static_cast<size_t>(pSymbol.getHash());
+    }
+};
+
+
+namespace SymbolLiterals {
+
+constexpr Symbol operator"" _sym (const char *pString, const size_t pLength) {
+    return Symbol(std::string_view(pString, pLength));
+}
+
+} // namespace SymbolLiterals
+
+} // namespace StringUtils
+} // namespace VcppBits
+
+
+namespace std {
+
+template <>
+struct hash<VcppBits::StringUtils::Symbol>
+    : VcppBits::StringUtils::SymbolHash {
+};
+
+} // namespace std
+
+
+#endif // VcppBits_SYMBOL_HPP_INCLUDED__
@@ -24,4 +24,6 @@
 
 
 #define CATCH_CONFIG_MAIN
+// glibc >= 2.34 makes SIGSTKSZ non-constant, which bundled catch2 can't handle
+#define CATCH_CONFIG_NO_POSIX_SIGNALS
 #include "VcppBits/contrib/catch2/catch.hpp"
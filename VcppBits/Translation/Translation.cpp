@@ -32,6 +32,9 @@
 #include "Ids.hpp"
 #include "Translation.hpp"
 
+#include <VcppBits/StringUtils/Builder.hpp>
+#include <VcppBits/StringUtils/LineReader.hpp>
+
 namespace VcppBits {
 namespace Translation {
 
@@ -135,12 +138,14 @@ const std::vector<std::string> &Translation::getLanguages () const {
 }
 
 void Translation::dumpTranslationData () {
-    std::ofstream file ("Data/Langs/English.example.txt");
+    StringUtils::Builder out(4096);
     for (const auto &el : mData["English"]) {
-        file << mIds.toString(el.first)
-             << " "
-             << el.second << '\n';
+        out << mIds.toString(el.first)
+            << ' '
+            << el.second << '\n';
     }
+    std::ofstream file ("Data/Langs/English.example.txt");
+    file.write(out.data(), std::streamsize(out.size()));
 }
 
 void Translation::loadTranslationFile (const std::string &pFile,
@@ -151,20 +156,21 @@ void Translation::loadTranslationFile (const std::string &pFile,
 
     std::map<Ids, std::string> dt;
 
-    std::string str;
-    while(!StringUtils::safeGetline(file, str).eof() || !file.fail()) {
-        str = StringUtils::trim(str, " \t");
+    StringUtils::LineReader reader(file);
+    std::string_view str;
+    while (reader.getLine(str)) {
+        str = StringUtils::trimView(str, " \t");
 
         if (str.length() > 0 && str.at(0) != '#') {
-            std::string::size_type separator_pos =
+            std::string_view::size_type separator_pos =
                 str.find_first_of(" \n\0", 0);
 
-            std::string name = str.substr(0, separator_pos);
-            std::string tr =
-                (separator_pos + 1 == std::string::npos
-                 || separator_pos == std::string::npos)
-                ? ""
-                : str.substr(separator_pos + 1);
+            std::string name(str.substr(0, separator_pos));
+            std::string tr(
+                (separator_pos + 1 == std::string_view::npos
+                 || separator_pos == std::string_view::npos)
+                ? std::string_view()
+                : str.substr(separator_pos + 1));
 
 
             try {